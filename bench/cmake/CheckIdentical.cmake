@@ -0,0 +1,33 @@
+# Compiles SOURCE to assembly twice, with and without -D${DEFINE}, and fails unless both outputs
+# are identical.
+#
+# cmake -DCOMPILER=<path> -DSOURCE=<file> -DINCLUDE_DIR=<dir> -DDEFINE=<macro> -DOUTPUT_DIR=<dir>
+# [-DFLAGS=<list>] -P CheckIdentical.cmake
+
+get_filename_component(source_name ${SOURCE} NAME_WE)
+set(asm_without ${OUTPUT_DIR}/${source_name}.s)
+set(asm_with ${OUTPUT_DIR}/${source_name}.${DEFINE}.s)
+
+function(compile asm)
+  execute_process(
+    COMMAND ${COMPILER} -std=c++17 -O3 ${FLAGS} ${ARGN} -I${INCLUDE_DIR} -S ${SOURCE} -o ${asm}
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output
+  )
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "compiling ${SOURCE} failed:\n${output}")
+  endif()
+endfunction()
+
+compile(${asm_without})
+compile(${asm_with} -D${DEFINE})
+
+file(READ ${asm_without} code_without)
+file(READ ${asm_with} code_with)
+if(NOT code_without STREQUAL code_with)
+  message(FATAL_ERROR "${source_name}: the code differs with -D${DEFINE}, compare ${asm_without} "
+                      "and ${asm_with}"
+  )
+endif()
+message(STATUS "${source_name}: identical code with and without -D${DEFINE}")
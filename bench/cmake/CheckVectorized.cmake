@@ -0,0 +1,60 @@
+# Compiles SOURCE with the compiler's vectorization remarks enabled and fails unless every line
+# marked `// vectorize` is reported as a vectorized loop.
+#
+# cmake -DCOMPILER=<path> -DCOMPILER_ID=<GNU|Clang|AppleClang> -DSOURCE=<file> -DINCLUDE_DIR=<dir>
+# [-DFLAGS=<list>] -P CheckVectorized.cmake
+
+if(COMPILER_ID STREQUAL "GNU")
+  set(remark_flags -fopt-info-vec-optimized)
+  set(remark "optimized: loop vectorized")
+elseif(COMPILER_ID MATCHES "Clang")
+  set(remark_flags -Rpass=loop-vectorize)
+  set(remark "remark: vectorized loop")
+else()
+  message(FATAL_ERROR "no vectorization remarks for compiler ${COMPILER_ID}")
+endif()
+
+file(STRINGS ${SOURCE} lines)
+set(hot_lines)
+set(number 0)
+foreach(line IN LISTS lines)
+  math(EXPR number "${number} + 1")
+  if(line MATCHES "// vectorize$")
+    list(APPEND hot_lines ${number})
+  endif()
+endforeach()
+if(NOT hot_lines)
+  message(FATAL_ERROR "${SOURCE} has no lines marked `// vectorize`")
+endif()
+
+if(CMAKE_HOST_WIN32)
+  set(null_device NUL)
+else()
+  set(null_device /dev/null)
+endif()
+
+execute_process(
+  COMMAND ${COMPILER} -std=c++17 -O3 ${FLAGS} -I${INCLUDE_DIR} ${remark_flags} -c ${SOURCE} -o
+          ${null_device}
+  RESULT_VARIABLE result
+  OUTPUT_VARIABLE output
+  ERROR_VARIABLE output
+)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "compiling ${SOURCE} failed:\n${output}")
+endif()
+
+get_filename_component(source_name ${SOURCE} NAME)
+set(missing)
+foreach(number IN LISTS hot_lines)
+  if(NOT output MATCHES "${source_name}:${number}:[0-9]+: ${remark}")
+    list(APPEND missing ${number})
+  endif()
+endforeach()
+
+if(missing)
+  string(REPLACE ";" ", " missing "${missing}")
+  message(FATAL_ERROR "loops no longer vectorized in ${source_name}, line(s) ${missing}")
+endif()
+list(LENGTH hot_lines count)
+message(STATUS "${count} hot loops vectorized in ${source_name}")
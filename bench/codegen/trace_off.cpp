@@ -0,0 +1,46 @@
+// Loops that are marked with PYRANGE_TRACED when MARKED is defined. The check
+// compiles this file to assembly with and without MARKED, with the trace switch
+// off, and fails unless both are identical. It is only compiled, never linked.
+
+#include <cstddef>                // for size_t
+#include <cstdint>                // for int32_t
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/range.hpp>      // for range
+#include <pyrange/robin.hpp>      // for Robin
+#include <pyrange/trace.hpp>      // for PYRANGE_TRACED
+#include <vector>                 // for vector
+
+#if defined(MARKED)
+#    define LOOP(...) PYRANGE_TRACED(__VA_ARGS__)
+#else
+#    define LOOP(...) __VA_ARGS__
+#endif
+
+void range_add(float *__restrict out, const float *__restrict a, const float *__restrict b,
+               size_t n) {
+    for (auto i : LOOP(py::range(n))) {
+        out[i] = a[i] + b[i];
+    }
+}
+
+auto step_range_sum(const int32_t *a, int n) -> int32_t {
+    auto total = int32_t(0);
+    for (auto i : LOOP(py::range(0, n, 3))) {
+        total += a[i];
+    }
+    return total;
+}
+
+void enumerate_scale(std::vector<double> &v) {
+    for (auto p : LOOP(py::enumerate(v))) {
+        p.second *= double(p.first);
+    }
+}
+
+auto robin_count(const fun::Robin<unsigned> &rr, unsigned from) -> unsigned {
+    auto count = 0U;
+    for (auto k : LOOP(rr.exclude(from))) {
+        count += k;
+    }
+    return count;
+}
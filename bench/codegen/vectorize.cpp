@@ -0,0 +1,72 @@
+// Hot loops that must stay vectorized. The check compiles this file with the
+// compiler's vectorization remarks enabled and fails unless a remark is reported
+// for every line marked `// vectorize`. It is only compiled, never linked.
+
+#include <cstddef>                // for size_t
+#include <cstdint>                // for int32_t
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/prefetch.hpp>   // for prefetched
+#include <pyrange/range.hpp>      // for range
+#include <pyrange/zip.hpp>        // for zip
+#include <tuple>                  // for get
+#include <vector>                 // for vector
+
+void range_add_int(int32_t *__restrict out, const int32_t *__restrict a,
+                   const int32_t *__restrict b, int n) {
+    for (auto i : py::range(n)) {  // vectorize
+        out[i] = a[i] + b[i];
+    }
+}
+
+void range_add_float(float *__restrict out, const float *__restrict a, const float *__restrict b,
+                     size_t n) {
+    for (auto i : py::range(n)) {  // vectorize
+        out[i] = a[i] + b[i];
+    }
+}
+
+void range_iota(double *__restrict out, int n) {
+    for (auto i : py::range(n)) {  // vectorize
+        out[i] = double(i);
+    }
+}
+
+void step_range_scale(float *__restrict out, const float *__restrict a, int n) {
+    for (auto i : py::range(0, n, 1)) {  // vectorize
+        out[i] = a[i] * 2.0F;
+    }
+}
+
+auto range_sum(const int32_t *a, int n) -> int32_t {
+    auto total = int32_t(0);
+    for (auto i : py::range(n)) {  // vectorize
+        total += a[i];
+    }
+    return total;
+}
+
+void enumerate_add_index(std::vector<int32_t> &a) {
+    for (const auto &p : py::enumerate(a)) {  // vectorize
+        p.second += int32_t(p.first);
+    }
+}
+
+void enumerate_scale_by_index(std::vector<float> &a) {
+    for (const auto &p : py::enumerate<int32_t>(a)) {  // vectorize
+        p.second *= float(p.first);
+    }
+}
+
+void zip_axpy(std::vector<float> &y, const std::vector<float> &x, float a) {
+    for (auto t : py::zip(y, x)) {  // vectorize
+        std::get<0>(t) += a * std::get<1>(t);
+    }
+}
+
+auto prefetched_contiguous_sum(const int32_t *a, size_t n) -> int32_t {
+    auto total = int32_t(0);
+    for (auto p : py::prefetched(py::range(a, a + n))) {  // vectorize
+        total += *p;
+    }
+    return total;
+}
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>                // for size_t
+#include <cstdint>                // for int64_t
+#include <pyrange/batch.hpp>      // for for_each_batch
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/range.hpp>      // for range
+#include <vector>                 // for vector
+
+namespace {
+
+    // out[i] = a[i] * w(i), where the weight is computed from the index itself
+
+    inline auto weight(int i) -> float { return float(i & 1023) * 0.25F + 1.0F; }
+
+    // The batch body is straight-line code, which the compiler cannot version
+    // for aliasing the way it versions a loop, hence the __restrict pointers.
+
+    void index_scalar(float *__restrict out, const float *__restrict a, int n) {
+        for (auto i : py::range(n)) {
+            out[i] = a[i] * weight(i);
+        }
+    }
+
+    void index_batch(float *__restrict out, const float *__restrict a, int n) {
+        py::for_each_batch(py::range(n), [out, a](const auto &b) {
+            const auto i0 = size_t(b[0]);
+            if (b.size() == b.width) {
+                for (size_t k = 0; k != b.width; ++k) {
+                    out[i0 + k] = a[i0 + k] * weight(int(i0 + k));
+                }
+            } else {
+                for (size_t k = 0; k != b.size(); ++k) {
+                    out[i0 + k] = a[i0 + k] * weight(int(i0 + k));
+                }
+            }
+        });
+    }
+
+    void enumerate_scalar(std::vector<float> &a) {
+        for (const auto &p : py::enumerate(a)) {
+            p.second *= weight(int(p.first));
+        }
+    }
+
+    void enumerate_batch(std::vector<float> &a) {
+        py::for_each_batch(py::enumerate(a), [](const auto &idx, const auto &elem) {
+            if (elem.size() == elem.width) {
+                for (size_t k = 0; k != elem.width; ++k) {
+                    elem[k] *= weight(int(idx[k]));
+                }
+            } else {
+                for (size_t k = 0; k != elem.size(); ++k) {
+                    elem[k] *= weight(int(idx[k]));
+                }
+            }
+        });
+    }
+
+    template <void (*Kernel)(float *, const float *, int)>
+    void BM_Index(benchmark::State &state) {
+        const auto n = int(state.range(0));
+        auto a = std::vector<float>(size_t(n), 2.0F);
+        auto out = std::vector<float>(size_t(n));
+        for (auto _ : state) {
+            Kernel(out.data(), a.data(), n);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+    BENCHMARK_TEMPLATE(BM_Index, index_scalar)->Arg(1000)->Arg(1 << 16)->Arg(1 << 22);
+    BENCHMARK_TEMPLATE(BM_Index, index_batch)->Arg(1000)->Arg(1 << 16)->Arg(1 << 22);
+
+    template <void (*Kernel)(std::vector<float> &)> void BM_Enumerate(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        auto a = std::vector<float>(n, 1.0F);
+        for (auto _ : state) {
+            Kernel(a);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n));
+    }
+    BENCHMARK_TEMPLATE(BM_Enumerate, enumerate_scalar)->Arg(1000)->Arg(1 << 16)->Arg(1 << 22);
+    BENCHMARK_TEMPLATE(BM_Enumerate, enumerate_batch)->Arg(1000)->Arg(1 << 16)->Arg(1 << 22);
+
+}  // namespace
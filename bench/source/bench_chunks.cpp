@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>           // for min
+#include <cstddef>             // for size_t
+#include <cstdint>             // for int64_t
+#include <pyrange/chunks.hpp>  // for chunks, windows
+#include <pyrange/range.hpp>   // for range
+#include <vector>              // for vector
+
+namespace {
+
+    // per-block sums of a buffer: chunk boundaries computed by hand against
+    // py::chunks; both should run at the same speed
+
+    constexpr size_t buffer_size = (1 << 20) + 123;  // with a tail chunk
+
+    void BM_ChunksManual(benchmark::State &state) {
+        const auto k = size_t(state.range(0));
+        const auto data = std::vector<float>(buffer_size, 1.0F);
+        auto sums = std::vector<float>((buffer_size + k - 1) / k);
+        for (auto _ : state) {
+            for (auto c : py::range(sums.size())) {
+                const auto first = c * k;
+                const auto last = std::min(first + k, data.size());
+                auto sum = 0.0F;
+                for (auto i : py::range(first, last)) {
+                    sum += data[i];
+                }
+                sums[c] = sum;
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(buffer_size));
+    }
+    BENCHMARK(BM_ChunksManual)->Arg(64)->Arg(4096);
+
+    void BM_Chunks(benchmark::State &state) {
+        const auto k = size_t(state.range(0));
+        const auto data = std::vector<float>(buffer_size, 1.0F);
+        auto sums = std::vector<float>((buffer_size + k - 1) / k);
+        for (auto _ : state) {
+            auto *out = sums.data();
+            for (auto chunk : py::chunks(data, k)) {
+                auto sum = 0.0F;
+                for (auto x : chunk) {
+                    sum += x;
+                }
+                *out++ = sum;
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(buffer_size));
+    }
+    BENCHMARK(BM_Chunks)->Arg(64)->Arg(4096);
+
+    // moving maximum over windows of 8
+
+    void BM_WindowsManual(benchmark::State &state) {
+        const auto data = std::vector<int>(buffer_size, 3);
+        auto out = std::vector<int>(buffer_size - 7);
+        for (auto _ : state) {
+            for (auto w : py::range(out.size())) {
+                auto m = data[w];
+                for (auto i : py::range(size_t(1), size_t(8))) {
+                    m = std::max(m, data[w + i]);
+                }
+                out[w] = m;
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(out.size()));
+    }
+    BENCHMARK(BM_WindowsManual);
+
+    void BM_Windows(benchmark::State &state) {
+        const auto data = std::vector<int>(buffer_size, 3);
+        auto out = std::vector<int>(buffer_size - 7);
+        for (auto _ : state) {
+            auto *o = out.data();
+            for (auto window : py::windows(data, 8)) {
+                auto m = window[0];
+                for (auto x : window) {
+                    m = std::max(m, x);
+                }
+                *o++ = m;
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(out.size()));
+    }
+    BENCHMARK(BM_Windows);
+
+}  // namespace
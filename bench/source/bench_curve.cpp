@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>              // for size_t
+#include <pyrange/curve.hpp>    // for morton, hilbert
+#include <pyrange/ndrange.hpp>  // for product
+#include <pyrange/range.hpp>    // for range
+#include <vector>               // for vector
+
+namespace {
+
+    // B = transpose(A) for an n x n matrix, with the (i, j) pairs visited in
+    // row-major, Z-order or Hilbert order.
+
+    template <typename Rng> void transpose(const Rng &order, int n, const std::vector<double> &A,
+                                           std::vector<double> &B) {
+        for (const auto &idx : order) {
+            B[size_t(idx[1]) * size_t(n) + size_t(idx[0])]
+                = A[size_t(idx[0]) * size_t(n) + size_t(idx[1])];
+        }
+    }
+
+    void BM_CurveRowMajor(benchmark::State &state) {
+        const auto n = int(state.range(0));
+        auto A = std::vector<double>(size_t(n) * size_t(n), 1.0);
+        auto B = std::vector<double>(A.size());
+        for (auto _ : state) {
+            transpose(py::product(py::range(n), py::range(n)), n, A, B);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(A.size()));
+    }
+    BENCHMARK(BM_CurveRowMajor)->Arg(1000)->Arg(3000)->Arg(4096);
+
+    void BM_CurveMorton(benchmark::State &state) {
+        const auto n = int(state.range(0));
+        auto A = std::vector<double>(size_t(n) * size_t(n), 1.0);
+        auto B = std::vector<double>(A.size());
+        for (auto _ : state) {
+            transpose(py::morton(py::range(n), py::range(n)), n, A, B);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(A.size()));
+    }
+    BENCHMARK(BM_CurveMorton)->Arg(1000)->Arg(3000)->Arg(4096);
+
+    void BM_CurveHilbert(benchmark::State &state) {
+        const auto n = int(state.range(0));
+        auto A = std::vector<double>(size_t(n) * size_t(n), 1.0);
+        auto B = std::vector<double>(A.size());
+        for (auto _ : state) {
+            transpose(py::hilbert(py::range(n), py::range(n)), n, A, B);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(A.size()));
+    }
+    BENCHMARK(BM_CurveHilbert)->Arg(1000)->Arg(3000)->Arg(4096);
+
+}  // namespace
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>             // for size_t
+#include <cstdint>             // for int64_t
+#include <filesystem>          // for temp_directory_path
+#include <fstream>             // for ifstream, ofstream
+#include <pyrange/mapped.hpp>  // for mapped_lines
+#include <pyrange/range.hpp>   // for range
+#include <string>              // for string, getline
+
+namespace {
+
+    // a 62 MB text file of lines of 0 to 119 characters, written once; both
+    // loops sum the line lengths, so they only differ in how they read
+
+    constexpr size_t num_lines = 1 << 20;
+
+    auto text_file() -> const std::string & {
+        static const auto path = [] {
+            auto name = (std::filesystem::temp_directory_path() / "pyrange_bench_lines.txt")
+                            .string();
+            auto out = std::ofstream(name, std::ios::binary);
+            for (auto i : py::range(num_lines)) {
+                out << std::string(i * 7919 % 120, 'x') << '\n';
+            }
+            return name;
+        }();
+        return path;
+    }
+
+    void BM_Getline(benchmark::State &state) {
+        const auto &path = text_file();
+        for (auto _ : state) {
+            auto in = std::ifstream(path, std::ios::binary);
+            auto line = std::string{};
+            auto total = size_t(0);
+            while (std::getline(in, line)) {
+                total += line.size();
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_lines));
+    }
+    BENCHMARK(BM_Getline)->Unit(benchmark::kMillisecond);
+
+    void BM_MappedLines(benchmark::State &state) {
+        const auto &path = text_file();
+        for (auto _ : state) {
+            auto total = size_t(0);
+            for (auto line : py::mapped_lines(path)) {
+                total += line.size();
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_lines));
+    }
+    BENCHMARK(BM_MappedLines)->Unit(benchmark::kMillisecond);
+
+}  // namespace
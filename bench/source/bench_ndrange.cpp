@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>              // for size_t
+#include <pyrange/ndrange.hpp>  // for ndrange
+#include <pyrange/range.hpp>    // for range
+#include <vector>               // for vector
+
+namespace {
+
+    // B = transpose(A) for an n x n matrix: the writes to B stride through memory
+    // by n elements, which is where the naive row-major order loses the cache.
+
+    void BM_TransposeNested(benchmark::State &state) {
+        const auto n = int(state.range(0));
+        auto A = std::vector<double>(size_t(n) * size_t(n), 1.0);
+        auto B = std::vector<double>(A.size());
+        for (auto _ : state) {
+            for (auto i : py::range(n)) {
+                for (auto j : py::range(n)) {
+                    B[size_t(j) * size_t(n) + size_t(i)] = A[size_t(i) * size_t(n) + size_t(j)];
+                }
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * int64_t(A.size() * 2 * sizeof(double)));
+    }
+    BENCHMARK(BM_TransposeNested)->Arg(1024)->Arg(4096);
+
+    void BM_TransposeNdRange(benchmark::State &state) {
+        const auto n = int(state.range(0));
+        auto A = std::vector<double>(size_t(n) * size_t(n), 1.0);
+        auto B = std::vector<double>(A.size());
+        for (auto _ : state) {
+            for (const auto &idx : py::ndrange({n, n})) {
+                B[size_t(idx[1]) * size_t(n) + size_t(idx[0])]
+                    = A[size_t(idx[0]) * size_t(n) + size_t(idx[1])];
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * int64_t(A.size() * 2 * sizeof(double)));
+    }
+    BENCHMARK(BM_TransposeNdRange)->Arg(1024)->Arg(4096);
+
+    void BM_TransposeTiled(benchmark::State &state) {
+        const auto n = int(state.range(0));
+        const auto t = size_t(state.range(1));
+        auto A = std::vector<double>(size_t(n) * size_t(n), 1.0);
+        auto B = std::vector<double>(A.size());
+        for (auto _ : state) {
+            for (const auto &idx : py::ndrange({n, n}, {t, t})) {
+                B[size_t(idx[1]) * size_t(n) + size_t(idx[0])]
+                    = A[size_t(idx[0]) * size_t(n) + size_t(idx[1])];
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * int64_t(A.size() * 2 * sizeof(double)));
+    }
+    BENCHMARK(BM_TransposeTiled)->ArgsProduct({{1024, 4096}, {16, 32, 64}});
+
+}  // namespace
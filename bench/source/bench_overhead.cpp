@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>                // for size_t
+#include <cstdint>                // for int32_t, int64_t, uint32_t
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/range.hpp>      // for range
+#include <pyrange/robin.hpp>      // for Robin
+#include <vector>                 // for vector
+
+namespace {
+
+    // Each abstraction against the loop it replaces. The pairs should run at the
+    // same speed; a gap means the abstraction is no longer free.
+
+    // out[i] = a[i] + b[i]
+
+    struct RawIndex {
+        template <typename T>
+        static void run(T *__restrict out, const T *__restrict a, const T *__restrict b, size_t n) {
+            for (size_t i = 0; i != n; ++i) {
+                out[i] = a[i] + b[i];
+            }
+        }
+    };
+
+    struct RawPointer {
+        template <typename T>
+        static void run(T *__restrict out, const T *__restrict a, const T *__restrict b, size_t n) {
+            for (const auto *last = a + n; a != last; ++a, ++b, ++out) {
+                *out = *a + *b;
+            }
+        }
+    };
+
+    struct PyRange {
+        template <typename T>
+        static void run(T *__restrict out, const T *__restrict a, const T *__restrict b, size_t n) {
+            for (auto i : py::range(n)) {
+                out[i] = a[i] + b[i];
+            }
+        }
+    };
+
+    template <typename Loop, typename T> void BM_Add(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        auto a = std::vector<T>(n, T(1));
+        auto b = std::vector<T>(n, T(2));
+        auto out = std::vector<T>(n);
+        for (auto _ : state) {
+            Loop::run(out.data(), a.data(), b.data(), n);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n));
+    }
+    BENCHMARK_TEMPLATE(BM_Add, RawIndex, int32_t)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Add, RawPointer, int32_t)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Add, PyRange, int32_t)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Add, RawIndex, float)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Add, RawPointer, float)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Add, PyRange, float)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Add, RawIndex, double)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Add, RawPointer, double)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Add, PyRange, double)->Arg(256)->Arg(4096)->Arg(1 << 20);
+
+    // a[i] += i
+
+    struct RawEnumerate {
+        template <typename T> static void run(std::vector<T> &a) {
+            for (size_t i = 0; i != a.size(); ++i) {
+                a[i] += T(i);
+            }
+        }
+    };
+
+    struct PyEnumerate {
+        template <typename T> static void run(std::vector<T> &a) {
+            for (const auto &p : py::enumerate(a)) {
+                p.second += T(p.first);
+            }
+        }
+    };
+
+    template <typename Loop, typename T> void BM_Enumerate(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        auto a = std::vector<T>(n, T(1));
+        for (auto _ : state) {
+            Loop::run(a);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n));
+    }
+    BENCHMARK_TEMPLATE(BM_Enumerate, RawEnumerate, int32_t)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Enumerate, PyEnumerate, int32_t)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Enumerate, RawEnumerate, double)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Enumerate, PyEnumerate, double)->Arg(256)->Arg(4096)->Arg(1 << 20);
+
+    // a[i] *= i over floats: a size_t index has no vector conversion to float
+    // on AVX2, a 32-bit one converts 8 lanes at a time
+
+    template <typename Index> void BM_EnumerateIndex(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        auto a = std::vector<float>(n, 1.0F);
+        for (auto _ : state) {
+            for (const auto &p : py::enumerate<Index>(a)) {
+                p.second *= float(p.first);
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n));
+    }
+    BENCHMARK_TEMPLATE(BM_EnumerateIndex, size_t)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_EnumerateIndex, int32_t)->Arg(256)->Arg(4096)->Arg(1 << 20);
+
+    // every part but `from`, in cyclic order: Robin::exclude against the modulo
+    // loop that partitioners write by hand
+
+    template <typename T> void BM_ModuloCycle(benchmark::State &state) {
+        const auto n = T(state.range(0));
+        auto from = T(0);
+        for (auto _ : state) {
+            auto total = T(0);
+            for (auto k = T(1); k != n; ++k) {
+                total += T((from + k) % n);
+            }
+            benchmark::DoNotOptimize(total);
+            from = from + 1 == n ? T(0) : T(from + 1);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n - 1));
+    }
+    BENCHMARK_TEMPLATE(BM_ModuloCycle, uint32_t)->Arg(16)->Arg(1024)->Arg(65536);
+    BENCHMARK_TEMPLATE(BM_ModuloCycle, size_t)->Arg(16)->Arg(1024)->Arg(65536);
+
+    template <typename T> void BM_RobinCycle(benchmark::State &state) {
+        const auto n = T(state.range(0));
+        const fun::Robin<T> rr(n);
+        auto from = T(0);
+        for (auto _ : state) {
+            auto total = T(0);
+            for (auto part : rr.exclude(from)) {
+                total += part;
+            }
+            benchmark::DoNotOptimize(total);
+            from = from + 1 == n ? T(0) : T(from + 1);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n - 1));
+    }
+    BENCHMARK_TEMPLATE(BM_RobinCycle, uint32_t)->Arg(16)->Arg(1024)->Arg(65536);
+    BENCHMARK_TEMPLATE(BM_RobinCycle, size_t)->Arg(16)->Arg(1024)->Arg(65536);
+
+}  // namespace
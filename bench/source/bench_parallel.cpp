@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>                 // for atomic
+#include <cmath>                  // for sqrt
+#include <cstdint>                // for uint64_t
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/parallel.hpp>   // for parallel_for_chunk, ThreadPool
+#include <pyrange/range.hpp>      // for range
+#include <vector>                 // for vector
+
+namespace {
+
+    // CPU-bound body: a few dozen dependent floating point operations per index
+    inline auto work(int i) -> double {
+        auto x = double(i);
+        for (auto k = 0; k != 32; ++k) {
+            x = std::sqrt(x + double(k));
+        }
+        return x;
+    }
+
+    constexpr auto N = 1 << 22;
+
+    void BM_Serial(benchmark::State &state) {
+        for (auto _ : state) {
+            auto total = 0.0;
+            for (auto i : py::range(N)) {
+                total += work(i);
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * N);
+    }
+    BENCHMARK(BM_Serial)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+    void BM_ParallelFor(benchmark::State &state) {
+        py::ThreadPool pool(size_t(state.range(0)) - 1);
+        for (auto _ : state) {
+            std::atomic<std::uint64_t> total{0};
+            py::parallel_for_chunk(pool, py::range(N), [&total](const auto &sub) {
+                auto local = 0.0;
+                for (auto i : sub) {
+                    local += work(i);
+                }
+                total += std::uint64_t(local);
+            });
+            benchmark::DoNotOptimize(total.load());
+        }
+        state.SetItemsProcessed(state.iterations() * N);
+    }
+    BENCHMARK(BM_ParallelFor)
+        ->RangeMultiplier(2)
+        ->Range(1, 64)
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+
+    void BM_ParallelForDeterministic(benchmark::State &state) {
+        py::ThreadPool pool(size_t(state.range(0)) - 1);
+        for (auto _ : state) {
+            std::atomic<std::uint64_t> total{0};
+            py::parallel_for_chunk(
+                pool, py::range(N),
+                [&total](const auto &sub) {
+                    auto local = 0.0;
+                    for (auto i : sub) {
+                        local += work(i);
+                    }
+                    total += std::uint64_t(local);
+                },
+                4096, py::Partition::Deterministic);
+            benchmark::DoNotOptimize(total.load());
+        }
+        state.SetItemsProcessed(state.iterations() * N);
+    }
+    BENCHMARK(BM_ParallelForDeterministic)
+        ->RangeMultiplier(2)
+        ->Range(1, 64)
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+
+    void BM_ParallelForEnumerate(benchmark::State &state) {
+        py::ThreadPool pool(size_t(state.range(0)) - 1);
+        auto values = std::vector<double>(N);
+        for (auto _ : state) {
+            py::parallel_for(pool, py::enumerate(values), [](const auto &p) {
+                p.second = work(int(p.first));
+            });
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * N);
+    }
+    BENCHMARK(BM_ParallelForEnumerate)
+        ->RangeMultiplier(2)
+        ->Range(1, 64)
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>             // for shuffle
+#include <cstddef>               // for size_t
+#include <cstdint>               // for int64_t, uint64_t
+#include <numeric>               // for iota
+#include <pyrange/permuted.hpp>  // for permuted
+#include <pyrange/range.hpp>     // for range
+#include <random>                // for mt19937_64
+#include <vector>                // for vector
+
+namespace {
+
+    // a shuffled sweep over a buffer, with a fresh order on every pass: a
+    // shuffled vector of indices against py::permuted, which allocates nothing
+
+    void BM_ShuffledVector(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        const auto data = std::vector<float>(n, 1.0F);
+        auto rng = std::mt19937_64{42};
+        for (auto _ : state) {
+            auto order = std::vector<size_t>(n);
+            std::iota(order.begin(), order.end(), size_t(0));
+            std::shuffle(order.begin(), order.end(), rng);
+            auto sum = 0.0F;
+            for (auto i : order) {
+                sum += data[i];
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n));
+    }
+    BENCHMARK(BM_ShuffledVector)->Arg(1 << 16)->Arg(1 << 22);
+
+    void BM_Permuted(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        const auto data = std::vector<float>(n, 1.0F);
+        auto seed = uint64_t(42);
+        for (auto _ : state) {
+            auto sum = 0.0F;
+            for (auto i : py::permuted(py::range(n), seed++)) {
+                sum += data[i];
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n));
+    }
+    BENCHMARK(BM_Permuted)->Arg(1 << 16)->Arg(1 << 22);
+
+}  // namespace
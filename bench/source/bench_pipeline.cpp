@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>               // for size_t
+#include <cstdint>               // for int64_t
+#include <pyrange/pipeline.hpp>  // for map, filter, take, accumulate
+#include <pyrange/range.hpp>     // for range
+#include <random>                // for mt19937_64, uniform_int_distribution
+#include <vector>                // for vector
+
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // for views
+#endif
+
+namespace {
+
+    // The sum of the squares of the odd elements: a hand-written loop, the
+    // push-based pipeline and, when available, the pull-based std::ranges
+    // pipeline. The first two should run at the same speed.
+
+    auto is_odd = [](int64_t x) { return (x & 1) != 0; };
+    auto square = [](int64_t x) { return x * x; };
+
+    auto make_data(size_t n) -> std::vector<int64_t> {
+        auto gen = std::mt19937_64(5489U);
+        auto dist = std::uniform_int_distribution<int64_t>(0, 999);
+        auto data = std::vector<int64_t>(n);
+        for (auto &x : data) {
+            x = dist(gen);
+        }
+        return data;
+    }
+
+    struct RawLoop {
+        static auto run(const std::vector<int64_t> &data, size_t /* limit */) -> int64_t {
+            auto total = int64_t(0);
+            for (auto x : data) {
+                if (is_odd(x)) {
+                    total += square(x);
+                }
+            }
+            return total;
+        }
+
+        static auto take(const std::vector<int64_t> &data, size_t limit) -> int64_t {
+            auto total = int64_t(0);
+            for (auto x : data) {
+                if (is_odd(x)) {
+                    total += square(x);
+                    if (--limit == 0) {
+                        break;
+                    }
+                }
+            }
+            return total;
+        }
+    };
+
+    struct PyPipeline {
+        static auto run(const std::vector<int64_t> &data, size_t /* limit */) -> int64_t {
+            return py::accumulate(py::map(square, py::filter(is_odd, data)), int64_t(0));
+        }
+
+        static auto take(const std::vector<int64_t> &data, size_t limit) -> int64_t {
+            return py::accumulate(py::take(limit, py::map(square, py::filter(is_odd, data))),
+                                  int64_t(0));
+        }
+    };
+
+#if defined(__cpp_lib_ranges)
+    struct StdRanges {
+        static auto run(const std::vector<int64_t> &data, size_t /* limit */) -> int64_t {
+            auto total = int64_t(0);
+            for (auto x : data | std::views::filter(is_odd) | std::views::transform(square)) {
+                total += x;
+            }
+            return total;
+        }
+
+        static auto take(const std::vector<int64_t> &data, size_t limit) -> int64_t {
+            auto total = int64_t(0);
+            for (auto x : data | std::views::filter(is_odd) | std::views::transform(square)
+                              | std::views::take(limit)) {
+                total += x;
+            }
+            return total;
+        }
+    };
+#endif
+
+    template <typename Loop> void BM_Pipeline(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        const auto data = make_data(n);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Loop::run(data, n));
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n));
+    }
+    BENCHMARK_TEMPLATE(BM_Pipeline, RawLoop)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Pipeline, PyPipeline)->Arg(4096)->Arg(1 << 20);
+#if defined(__cpp_lib_ranges)
+    BENCHMARK_TEMPLATE(BM_Pipeline, StdRanges)->Arg(4096)->Arg(1 << 20);
+#endif
+
+    // the same, stopped after a quarter of the odd elements
+    template <typename Loop> void BM_PipelineTake(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        const auto data = make_data(n);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Loop::take(data, n / 8));
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n / 4));
+    }
+    BENCHMARK_TEMPLATE(BM_PipelineTake, RawLoop)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_PipelineTake, PyPipeline)->Arg(4096)->Arg(1 << 20);
+#if defined(__cpp_lib_ranges)
+    BENCHMARK_TEMPLATE(BM_PipelineTake, StdRanges)->Arg(4096)->Arg(1 << 20);
+#endif
+
+    // the sum of the squares of the odd numbers below n, straight from py::range
+    void BM_PipelineRange(benchmark::State &state) {
+        const auto n = int64_t(state.range(0));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(
+                py::accumulate(py::map(square, py::filter(is_odd, py::range(n))), int64_t(0)));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+    BENCHMARK(BM_PipelineRange)->Arg(4096)->Arg(1 << 20);
+
+}  // namespace
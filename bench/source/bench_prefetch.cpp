@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>              // for shuffle
+#include <cstddef>                // for size_t
+#include <cstdint>                // for int64_t
+#include <memory>                 // for unique_ptr
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/prefetch.hpp>   // for prefetched
+#include <pyrange/range.hpp>      // for range
+#include <random>                 // for mt19937_64
+#include <vector>                 // for vector
+
+namespace {
+
+    // a pool of 64-byte nodes, far larger than the last level cache, reached
+    // through an array of pointers (or indices) in random order: every node
+    // load misses. The plain loops only overlap the misses that fit in the
+    // out-of-order window; the prefetched ones start them `distance` elements
+    // early. The argument of the prefetched runs is the distance.
+
+    struct alignas(64) Node {
+        int64_t value;
+    };
+
+    constexpr size_t num_nodes = 1 << 20;  // 64 MB
+
+    struct Pool {
+        std::unique_ptr<Node[]> nodes{new Node[num_nodes]};
+        std::vector<Node *> ptrs;
+        std::vector<int> index;
+
+        Pool() {
+            auto order = std::vector<int>{};
+            for (auto i : py::range(int(num_nodes))) {
+                this->nodes[size_t(i)].value = i % 7;
+                order.push_back(i);
+            }
+            std::shuffle(order.begin(), order.end(), std::mt19937_64{42});
+            for (auto i : order) {
+                this->ptrs.push_back(&this->nodes[size_t(i)]);
+            }
+            this->index = order;
+        }
+
+        static auto instance() -> const Pool & {
+            static const Pool pool;
+            return pool;
+        }
+    };
+
+    void BM_PointerGather(benchmark::State &state) {
+        const auto &pool = Pool::instance();
+        const auto *first = pool.ptrs.data();
+        for (auto _ : state) {
+            auto sum = int64_t(0);
+            for (auto p : py::range(first, first + num_nodes)) {
+                sum += (*p)->value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_nodes));
+    }
+    BENCHMARK(BM_PointerGather);
+
+    void BM_PointerGatherPrefetched(benchmark::State &state) {
+        const auto &pool = Pool::instance();
+        const auto *first = pool.ptrs.data();
+        const auto distance = size_t(state.range(0));
+        for (auto _ : state) {
+            auto sum = int64_t(0);
+            for (auto p : py::prefetched(py::range(first, first + num_nodes), distance)) {
+                sum += (*p)->value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_nodes));
+    }
+    BENCHMARK(BM_PointerGatherPrefetched)->Arg(4)->Arg(16)->Arg(64);
+
+    void BM_EnumerateGather(benchmark::State &state) {
+        const auto &pool = Pool::instance();
+        for (auto _ : state) {
+            auto sum = int64_t(0);
+            for (const auto &p : py::enumerate(pool.ptrs)) {
+                sum += int64_t(p.first) * p.second->value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_nodes));
+    }
+    BENCHMARK(BM_EnumerateGather);
+
+    void BM_EnumerateGatherPrefetched(benchmark::State &state) {
+        const auto &pool = Pool::instance();
+        for (auto _ : state) {
+            auto sum = int64_t(0);
+            for (const auto &p : py::prefetched(py::enumerate(pool.ptrs))) {
+                sum += int64_t(p.first) * p.second->value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_nodes));
+    }
+    BENCHMARK(BM_EnumerateGatherPrefetched);
+
+    void BM_PrefetchedEnumerateGather(benchmark::State &state) {
+        const auto &pool = Pool::instance();
+        for (auto _ : state) {
+            auto sum = int64_t(0);
+            for (const auto &p : py::enumerate(py::prefetched(pool.ptrs))) {
+                sum += int64_t(p.first) * p.second->value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_nodes));
+    }
+    BENCHMARK(BM_PrefetchedEnumerateGather);
+
+    void BM_VectorGatherPrefetched(benchmark::State &state) {
+        const auto &pool = Pool::instance();
+        for (auto _ : state) {
+            auto sum = int64_t(0);
+            for (const auto *p : py::prefetched(pool.ptrs)) {
+                sum += p->value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_nodes));
+    }
+    BENCHMARK(BM_VectorGatherPrefetched);
+
+    void BM_IndexGather(benchmark::State &state) {
+        const auto &pool = Pool::instance();
+        const auto *nodes = pool.nodes.get();
+        for (auto _ : state) {
+            auto sum = int64_t(0);
+            for (auto i : pool.index) {
+                sum += nodes[i].value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_nodes));
+    }
+    BENCHMARK(BM_IndexGather);
+
+    void BM_IndexGatherPrefetched(benchmark::State &state) {
+        const auto &pool = Pool::instance();
+        const auto *nodes = pool.nodes.get();
+        const auto at = [nodes](int i) { return &nodes[i]; };
+        for (auto _ : state) {
+            auto sum = int64_t(0);
+            for (auto i : py::prefetched(pool.index, 0, at)) {
+                sum += nodes[i].value;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_nodes));
+    }
+    BENCHMARK(BM_IndexGatherPrefetched);
+
+    // a contiguous scan, which the hardware prefetcher already covers: the
+    // prefetched loop should not be slower
+
+    void BM_ContiguousScan(benchmark::State &state) {
+        const auto data = std::vector<double>(num_nodes * 8, 1.0);
+        const auto *first = data.data();
+        for (auto _ : state) {
+            auto sum = 0.0;
+            for (auto p : py::range(first, first + data.size())) {
+                sum += *p;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(data.size()));
+    }
+    BENCHMARK(BM_ContiguousScan);
+
+    void BM_ContiguousScanPrefetched(benchmark::State &state) {
+        const auto data = std::vector<double>(num_nodes * 8, 1.0);
+        const auto *first = data.data();
+        for (auto _ : state) {
+            auto sum = 0.0;
+            for (auto p : py::prefetched(py::range(first, first + data.size()))) {
+                sum += *p;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(data.size()));
+    }
+    BENCHMARK(BM_ContiguousScanPrefetched);
+
+}  // namespace
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>             // for size_t
+#include <cstdint>             // for int64_t
+#include <functional>          // for plus
+#include <pyrange/range.hpp>   // for range
+#include <pyrange/reduce.hpp>  // for sum, reduce, count_if
+#include <vector>              // for vector
+
+namespace {
+
+    // sum of an index range: element by element against the closed form
+
+    void BM_SumRangeLoop(benchmark::State &state) {
+        const auto n = int64_t(state.range(0));
+        for (auto _ : state) {
+            auto total = int64_t(0);
+            for (auto i : py::range(n)) {
+                total += i;
+                benchmark::DoNotOptimize(total);  // keep the loop from being folded
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+    BENCHMARK(BM_SumRangeLoop)->Arg(4096)->Arg(1 << 20);
+
+    void BM_SumRange(benchmark::State &state) {
+        auto n = int64_t(state.range(0));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(n);
+            benchmark::DoNotOptimize(py::sum(py::range(n), int64_t(0)));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+    BENCHMARK(BM_SumRange)->Arg(4096)->Arg(1 << 20);
+
+    // sum of doubles: the left-to-right loop, which the compiler may not
+    // reorder, against py::reduce on one thread and on the global pool
+
+    auto make_data(size_t n) -> std::vector<double> {
+        auto data = std::vector<double>(n);
+        for (auto i : py::range(n)) {
+            data[i] = 1.0 / double(i + 1);
+        }
+        return data;
+    }
+
+    void BM_SumLoop(benchmark::State &state) {
+        const auto data = make_data(size_t(state.range(0)));
+        for (auto _ : state) {
+            auto total = 0.0;
+            for (auto x : data) {
+                total += x;
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(data.size()));
+    }
+    BENCHMARK(BM_SumLoop)->Arg(4096)->Arg(1 << 20)->Arg(1 << 24);
+
+    template <py::Partition P> void BM_Reduce(benchmark::State &state) {
+        const auto data = make_data(size_t(state.range(0)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(py::reduce(data, 0.0, std::plus<>{}, P));
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(data.size()));
+    }
+    BENCHMARK_TEMPLATE(BM_Reduce, py::Partition::Adaptive)
+        ->Arg(4096)
+        ->Arg(1 << 20)
+        ->Arg(1 << 24)
+        ->UseRealTime();
+    BENCHMARK_TEMPLATE(BM_Reduce, py::Partition::Deterministic)
+        ->Arg(4096)
+        ->Arg(1 << 20)
+        ->Arg(1 << 24)
+        ->UseRealTime();
+
+    void BM_ReduceSerial(benchmark::State &state) {
+        const auto data = make_data(size_t(state.range(0)));
+        py::ThreadPool pool(0);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(py::reduce(pool, data, 0.0, std::plus<>{}));
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(data.size()));
+    }
+    BENCHMARK(BM_ReduceSerial)->Arg(4096)->Arg(1 << 20)->Arg(1 << 24);
+
+}  // namespace
@@ -0,0 +1,231 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>            // for size_t
+#include <cstdint>            // for uint32_t
+#include <mutex>              // for mutex, lock_guard
+#include <pyrange/robin.hpp>  // for Robin, ArithRobin, ConcurrentRobin, ...
+#include <random>             // for mt19937
+#include <vector>             // for vector
+
+namespace {
+
+    // One Robin per worker, as in a partitioner that keeps one per thread; each
+    // round visits all parts but one of every Robin.
+
+    constexpr auto num_robins = 64U;
+
+    template <typename Robin> void BM_Robin(benchmark::State &state) {
+        const auto n = uint32_t(state.range(0));
+        auto robins = std::vector<Robin>(num_robins, Robin(n));
+        for (auto _ : state) {
+            auto total = uint32_t(0);
+            for (auto r = 0U; r != num_robins; ++r) {
+                for (auto part : robins[r].exclude(r % n)) {
+                    total += part;
+                }
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_robins) * (n - 1));
+    }
+    BENCHMARK_TEMPLATE(BM_Robin, fun::Robin<uint32_t>)->Arg(16)->Arg(1024)->Arg(65536);
+    BENCHMARK_TEMPLATE(BM_Robin, fun::ArithRobin<uint32_t>)->Arg(16)->Arg(1024)->Arg(65536);
+
+
+    // Every other part is drained: skipping them through the links against
+    // filtering them inside the loop body.
+
+    void BM_RobinDeactivated(benchmark::State &state) {
+        const auto n = uint32_t(state.range(0));
+        auto robins = std::vector<fun::Robin<uint32_t>>(num_robins, fun::Robin<uint32_t>(n));
+        for (auto &robin : robins) {
+            for (auto part = 1U; part < n; part += 2) {
+                robin.deactivate(part);
+            }
+        }
+        for (auto _ : state) {
+            auto total = uint32_t(0);
+            for (auto r = 0U; r != num_robins; ++r) {
+                for (auto part : robins[r].exclude(r % n)) {
+                    total += part;
+                }
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_robins) * (n / 2));
+    }
+    BENCHMARK(BM_RobinDeactivated)->Arg(1024)->Arg(65536);
+
+    void BM_RobinFiltered(benchmark::State &state) {
+        const auto n = uint32_t(state.range(0));
+        auto robins = std::vector<fun::Robin<uint32_t>>(num_robins, fun::Robin<uint32_t>(n));
+        auto drained = std::vector<char>(n);
+        for (auto part = 1U; part < n; part += 2) {
+            drained[part] = 1;
+        }
+        for (auto _ : state) {
+            auto total = uint32_t(0);
+            for (auto r = 0U; r != num_robins; ++r) {
+                for (auto part : robins[r].exclude(r % n)) {
+                    if (drained[part] == 0) {
+                        total += part;
+                    }
+                }
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_robins) * (n / 2));
+    }
+    BENCHMARK(BM_RobinFiltered)->Arg(1024)->Arg(65536);
+
+    // Locked parts in a bitmask, each part with probability locked / 8: word-level
+    // bit scans in exclude(mask, from) against filtering inside the loop body.
+
+    auto locked_mask(uint32_t n, uint32_t locked) -> std::vector<uint64_t> {
+        auto gen = std::mt19937(7);
+        auto mask = std::vector<uint64_t>((n + 63) / 64);
+        for (auto part = 0U; part != n; ++part) {
+            if (gen() % 8 < locked) {
+                mask[part / 64] |= uint64_t(1) << (part % 64);
+            }
+        }
+        return mask;
+    }
+
+    void BM_RobinMasked(benchmark::State &state) {
+        const auto n = uint32_t(state.range(0));
+        auto robins = std::vector<fun::Robin<uint32_t>>(num_robins, fun::Robin<uint32_t>(n));
+        const auto mask = locked_mask(n, uint32_t(state.range(1)));
+        auto visited = int64_t(0);
+        for (auto _ : state) {
+            auto total = uint32_t(0);
+            for (auto r = 0U; r != num_robins; ++r) {
+                for (auto part : robins[r].exclude(mask, r % n)) {
+                    total += part;
+                    ++visited;
+                }
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(visited);
+    }
+    BENCHMARK(BM_RobinMasked)->ArgsProduct({{64, 1024, 65536}, {1, 4, 7}});
+
+    void BM_RobinMaskFiltered(benchmark::State &state) {
+        const auto n = uint32_t(state.range(0));
+        auto robins = std::vector<fun::Robin<uint32_t>>(num_robins, fun::Robin<uint32_t>(n));
+        const auto mask = locked_mask(n, uint32_t(state.range(1)));
+        auto visited = int64_t(0);
+        for (auto _ : state) {
+            auto total = uint32_t(0);
+            for (auto r = 0U; r != num_robins; ++r) {
+                for (auto part : robins[r].exclude(r % n)) {
+                    if ((mask[part / 64] >> (part % 64) & 1U) == 0) {
+                        total += part;
+                        ++visited;
+                    }
+                }
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(visited);
+    }
+    BENCHMARK(BM_RobinMaskFiltered)->ArgsProduct({{64, 1024, 65536}, {1, 4, 7}});
+
+    // Producers picking the shard for their next piece of work: a lock-free
+    // ConcurrentRobin against a Robin guarded by a mutex.
+
+    constexpr auto num_shards = 16U;
+
+    fun::ConcurrentRobin<uint32_t> concurrent_robin(num_shards);
+
+    void BM_ConcurrentRobin(benchmark::State &state) {
+        const auto self = uint32_t(state.thread_index()) % num_shards;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(concurrent_robin.next_excluding(self));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ConcurrentRobin)->ThreadRange(1, 8)->UseRealTime();
+
+    std::mutex robin_mutex;
+    fun::Robin<uint32_t> locked_robin(num_shards);
+    uint32_t locked_cursor = 0;
+
+    void BM_LockedRobin(benchmark::State &state) {
+        const auto self = uint32_t(state.thread_index()) % num_shards;
+        for (auto _ : state) {
+            auto part = uint32_t(0);
+            {
+                std::lock_guard<std::mutex> lock(robin_mutex);
+                part = *locked_robin.exclude(locked_cursor).begin();
+                if (part == self) {
+                    part = *locked_robin.exclude(part).begin();
+                }
+                locked_cursor = part;
+            }
+            benchmark::DoNotOptimize(part);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_LockedRobin)->ThreadRange(1, 8)->UseRealTime();
+
+    // Selection cost per pick of a weighted round: WeightedRobin against the
+    // O(n) scan of nginx's smooth weighted round robin. Both spread the picks
+    // evenly, but they do not yield the same sequence.
+
+    auto random_weights(size_t n) -> std::vector<size_t> {
+        auto gen = std::mt19937(7);
+        auto weights = std::vector<size_t>(n);
+        for (auto &w : weights) {
+            w = 1 + gen() % 8;
+        }
+        return weights;
+    }
+
+    void BM_WeightedRobin(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        const fun::WeightedRobin<uint32_t> wr(random_weights(n));
+        auto picks = int64_t(0);
+        for (auto _ : state) {
+            auto total = uint32_t(0);
+            for (auto part : wr.exclude(0)) {
+                total += part;
+                ++picks;
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(picks);
+    }
+    BENCHMARK(BM_WeightedRobin)->Arg(16)->Arg(256)->Arg(4096);
+
+    void BM_NginxWeighted(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        const auto weights = random_weights(n);
+        auto sum = int64_t(0);
+        for (auto w : weights) {
+            sum += int64_t(w);
+        }
+        auto current = std::vector<int64_t>(n, 0);
+        auto picks = int64_t(0);
+        for (auto _ : state) {
+            auto total = uint32_t(0);
+            for (auto step = sum; step != 0; --step) {
+                auto best = size_t(0);
+                for (size_t i = 0; i != n; ++i) {
+                    current[i] += int64_t(weights[i]);
+                    if (current[i] > current[best]) {
+                        best = i;
+                    }
+                }
+                current[best] -= sum;
+                total += uint32_t(best);
+                ++picks;
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(picks);
+    }
+    BENCHMARK(BM_NginxWeighted)->Arg(16)->Arg(256)->Arg(4096);
+
+}  // namespace
@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <array>                     // for array
+#include <cstddef>                   // for size_t
+#include <cstdint>                   // for int64_t
+#include <memory>                    // for unique_ptr
+#include <pyrange/range.hpp>         // for range
+#include <pyrange/static_range.hpp>  // for static_for
+#include <vector>                    // for vector
+
+namespace {
+
+    // Small fixed-size kernels over many independent blocks. The run-time loops
+    // get their bound from a variable the compiler cannot see through, as in a
+    // kernel that is not specialized for its size; static_for has it as a
+    // template argument and is fully unrolled.
+
+    constexpr size_t num_blocks = 1024;
+
+    template <size_t N> using Block = std::array<float, N * N>;
+
+    template <size_t N> struct Matrices {
+        std::array<Block<N>, num_blocks> a, b, c;
+
+        Matrices() {
+            for (auto k : py::range(num_blocks)) {
+                for (auto i : py::range(N * N)) {
+                    this->a[k][i] = float(i % 7) * 0.25F;
+                    this->b[k][i] = float(i % 5) * 0.5F;
+                }
+            }
+        }
+    };
+
+    // c = a * b for each block
+
+    template <size_t N> void BM_MatMulRange(benchmark::State &state) {
+        auto m = std::unique_ptr<Matrices<N>>(new Matrices<N>());
+        auto n = N;
+        benchmark::DoNotOptimize(n);
+        for (auto _ : state) {
+            for (auto k : py::range(num_blocks)) {
+                const auto &a = m->a[k];
+                const auto &b = m->b[k];
+                auto &c = m->c[k];
+                for (auto i : py::range(n)) {
+                    for (auto j : py::range(n)) {
+                        auto sum = 0.0F;
+                        for (auto l : py::range(n)) {
+                            sum += a[i * n + l] * b[l * n + j];
+                        }
+                        c[i * n + j] = sum;
+                    }
+                }
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_blocks));
+    }
+    BENCHMARK_TEMPLATE(BM_MatMulRange, 2);
+    BENCHMARK_TEMPLATE(BM_MatMulRange, 4);
+    BENCHMARK_TEMPLATE(BM_MatMulRange, 8);
+
+    template <size_t N> void BM_MatMulStatic(benchmark::State &state) {
+        auto m = std::unique_ptr<Matrices<N>>(new Matrices<N>());
+        for (auto _ : state) {
+            for (auto k : py::range(num_blocks)) {
+                const auto &a = m->a[k];
+                const auto &b = m->b[k];
+                auto &c = m->c[k];
+                py::static_for<N>([&](auto i) {
+                    py::static_for<N>([&](auto j) {
+                        auto sum = 0.0F;
+                        py::static_for<N>([&](auto l) { sum += a[i * N + l] * b[l * N + j]; });
+                        c[i * N + j] = sum;
+                    });
+                });
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_blocks));
+    }
+    BENCHMARK_TEMPLATE(BM_MatMulStatic, 2);
+    BENCHMARK_TEMPLATE(BM_MatMulStatic, 4);
+    BENCHMARK_TEMPLATE(BM_MatMulStatic, 8);
+
+    // fixed fan-out: every node adds its value to its `F` children
+
+    template <size_t F> void BM_FanOutRange(benchmark::State &state) {
+        auto values = std::vector<float>(num_blocks * F);
+        benchmark::DoNotOptimize(values.data());
+        auto fan_out = F;
+        benchmark::DoNotOptimize(fan_out);
+        for (auto _ : state) {
+            for (auto k : py::range(num_blocks)) {
+                for (auto f : py::range(fan_out)) {
+                    values[k * fan_out + f] += float(k);
+                }
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_blocks));
+    }
+    BENCHMARK_TEMPLATE(BM_FanOutRange, 3);
+    BENCHMARK_TEMPLATE(BM_FanOutRange, 8);
+
+    template <size_t F> void BM_FanOutStatic(benchmark::State &state) {
+        auto values = std::vector<float>(num_blocks * F);
+        benchmark::DoNotOptimize(values.data());
+        for (auto _ : state) {
+            for (auto k : py::range(num_blocks)) {
+                py::static_for<F>([&](auto f) { values[k * F + f] += float(k); });
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(num_blocks));
+    }
+    BENCHMARK_TEMPLATE(BM_FanOutStatic, 3);
+    BENCHMARK_TEMPLATE(BM_FanOutStatic, 8);
+
+}  // namespace
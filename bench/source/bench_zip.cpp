@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>                // for size_t
+#include <cstdint>                // for int64_t
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/zip.hpp>        // for zip, for_each_zip
+#include <tuple>                  // for get
+#include <vector>                 // for vector
+
+namespace {
+
+    // A struct-of-arrays update, pos += vel * dt, written against plain
+    // vectors. The indexed loops cannot prove that the vectors do not overlap;
+    // for_each_zip can.
+
+    constexpr float dt = 0.01F;
+
+    struct Soa {
+        std::vector<float> px, py, vx, vy;
+
+        explicit Soa(size_t n) : px(n, 0.0F), py(n, 0.0F), vx(n, 1.0F), vy(n, 2.0F) {}
+    };
+
+    struct IndexLoop {
+        static void run(Soa &s) {
+            for (size_t i = 0; i != s.px.size(); ++i) {
+                s.px[i] += s.vx[i] * dt;
+                s.py[i] += s.vy[i] * dt;
+            }
+        }
+    };
+
+    struct EnumerateLoop {
+        static void run(Soa &s) {
+            for (const auto &p : py::enumerate(s.px)) {
+                p.second += s.vx[p.first] * dt;
+                s.py[p.first] += s.vy[p.first] * dt;
+            }
+        }
+    };
+
+    struct ZipLoop {
+        static void run(Soa &s) {
+            for (auto t : py::zip(s.px, s.py, s.vx, s.vy)) {
+                std::get<0>(t) += std::get<2>(t) * dt;
+                std::get<1>(t) += std::get<3>(t) * dt;
+            }
+        }
+    };
+
+    struct ForEachZip {
+        static void run(Soa &s) {
+            py::for_each_zip(py::zip(s.px, s.py, s.vx, s.vy),
+                             [](float &x, float &y, float u, float v) {
+                                 x += u * dt;
+                                 y += v * dt;
+                             });
+        }
+    };
+
+    template <typename Loop> void BM_Zip(benchmark::State &state) {
+        const auto n = size_t(state.range(0));
+        auto s = Soa(n);
+        for (auto _ : state) {
+            Loop::run(s);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * int64_t(n));
+    }
+    BENCHMARK_TEMPLATE(BM_Zip, IndexLoop)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Zip, EnumerateLoop)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Zip, ZipLoop)->Arg(256)->Arg(4096)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_Zip, ForEachZip)->Arg(256)->Arg(4096)->Arg(1 << 20);
+
+}  // namespace
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <cstddef>  // import size_t
+#include <iterator>
+#include <type_traits>
+#include <utility>  // import std::declval
+
+#include "enumerate.hpp"
+#include "range.hpp"
+
+/**
+ * @brief PYRANGE_SIMD_BYTES
+ *
+ * Width of a SIMD register of the instruction set the code is compiled for:
+ * 64 bytes for AVX-512, 32 bytes for AVX/AVX2 and 16 bytes otherwise (SSE2 is
+ * part of x86-64, and NEON is 16 bytes wide as well). Define it before
+ * including this header to override the choice.
+ */
+#ifndef PYRANGE_SIMD_BYTES
+#    if defined(__AVX512F__)
+#        define PYRANGE_SIMD_BYTES 64
+#    elif defined(__AVX__)
+#        define PYRANGE_SIMD_BYTES 32
+#    else
+#        define PYRANGE_SIMD_BYTES 16
+#    endif
+#endif
+
+namespace py {
+
+    /**
+     * @brief simd_width<T>
+     *
+     * The number of values of type `T` that fit into one SIMD register.
+     *
+     * @tparam T
+     */
+    template <typename T> constexpr size_t simd_width
+        = sizeof(T) >= PYRANGE_SIMD_BYTES ? 1 : PYRANGE_SIMD_BYTES / sizeof(T);
+
+    namespace detail {
+
+        constexpr auto lowest_bit(size_t x) -> size_t { return x & (~x + 1); }
+
+    }  // namespace detail
+
+    /**
+     * @brief Batch
+     *
+     * The `Batch` struct holds `W` consecutive values (the lanes of one SIMD
+     * register) that are handed to the body of `for_each_batch`. Since `W` is a
+     * compile-time constant and the lanes are suitably aligned, a loop over the
+     * lanes in the body is fully unrolled and mapped onto vector instructions.
+     * In a full batch of a unit-step range lane `k` equals `b[0] + k`; prefer
+     * `b[0] + k` over `b[k]` in the body, both to address memory (`p[b[k]]` is a
+     * gather to the compiler) and as a value, since an induction is easier to
+     * vectorize than a load from the lanes.
+     *
+     * In the last batch of a range only the first `size()` lanes are active, and
+     * the body must mask the others with `active(k)` (or stop at `size()`):
+     * `b[0] + k` is past the end of the range for an inactive lane, and a
+     * reduction over all `W` lanes would count values twice. The inactive lanes
+     * repeat the value of the last active lane, so that reading them is harmless.
+     *
+     * @tparam T
+     * @tparam W
+     */
+    template <typename T, size_t W> struct Batch {
+        static constexpr size_t width = W;
+
+        // the largest power of two that divides the size of the lanes: their
+        // size itself for the usual power-of-two `W`, and still valid for others
+        alignas(detail::lowest_bit(sizeof(T) * W)) T lane[W];
+        size_t count;  // number of active lanes
+
+        /**
+         * @brief
+         *
+         * @param[in] k
+         * @return const T&
+         */
+        constexpr auto operator[](size_t k) const -> const T & { return this->lane[k]; }
+
+        /**
+         * @brief size
+         *
+         * Returns the number of active lanes (`W`, except in the tail).
+         *
+         * @return size_t
+         */
+        constexpr auto size() const -> size_t { return this->count; }
+
+        /**
+         * @brief active
+         *
+         * Returns whether lane `k` is active, i.e. the mask of the tail batch.
+         *
+         * @param[in] k
+         * @return true
+         * @return false
+         */
+        constexpr auto active(size_t k) const -> bool { return k < this->count; }
+    };
+
+    /**
+     * @brief BatchView
+     *
+     * The `BatchView` struct refers to `W` consecutive elements of a contiguous
+     * container without copying them, so that the body of `for_each_batch` can
+     * read and write them. Only the first `size()` elements are valid.
+     *
+     * @tparam T
+     * @tparam W
+     */
+    template <typename T, size_t W> struct BatchView {
+        static constexpr size_t width = W;
+
+        T *data;
+        size_t count;  // number of valid elements
+
+        /**
+         * @brief
+         *
+         * @param[in] k
+         * @return T&
+         */
+        constexpr auto operator[](size_t k) const -> T & { return this->data[k]; }
+
+        /**
+         * @brief size
+         *
+         * @return size_t
+         */
+        constexpr auto size() const -> size_t { return this->count; }
+
+        /**
+         * @brief active
+         *
+         * @param[in] k
+         * @return true
+         * @return false
+         */
+        constexpr auto active(size_t k) const -> bool { return k < this->count; }
+    };
+
+    namespace detail {
+
+        template <size_t W, typename Rng, typename Body>
+        inline void for_each_batch_impl(const Rng &rng, Body &&body) {
+            using T = typename Rng::value_type;
+            const auto n = rng.size();
+            const auto full = n - n % W;
+            auto batch = Batch<T, W>{{}, W};
+            // only values of the range are computed: one batch past `full` could
+            // overflow for a range that ends near the largest value of `T`
+            for (size_t base = 0; base != full; base += W) {
+                for (size_t k = 0; k != W; ++k) {
+                    batch.lane[k] = rng[base + k];
+                }
+                body(static_cast<const Batch<T, W> &>(batch));
+            }
+            if (full != n) {
+                batch.count = n - full;
+                for (size_t k = 0; k != W; ++k) {
+                    batch.lane[k] = rng[full + (k < batch.count ? k : batch.count - 1)];
+                }
+                body(static_cast<const Batch<T, W> &>(batch));
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief for_each_batch<W>(const Range<T> &rng, Body &&body)
+     *
+     * The `for_each_batch` function calls `body` with batches of `W`
+     * consecutive values of `rng` (an iota vector), instead of one value at a
+     * time. The last batch may be partial; see `Batch`.
+     *
+     * @tparam W lanes per batch
+     * @tparam T
+     * @tparam Body
+     * @param[in] rng
+     * @param[in] body
+     */
+    template <size_t W, typename T, typename Body>
+    inline void for_each_batch(const Range<T> &rng, Body &&body) {
+        detail::for_each_batch_impl<W>(rng, body);
+    }
+
+    /**
+     * @brief for_each_batch(const Range<T> &rng, Body &&body)
+     *
+     * Same as above, with `W = simd_width<T>`.
+     *
+     * @tparam T
+     * @tparam Body
+     * @param[in] rng
+     * @param[in] body
+     */
+    template <typename T, typename Body>
+    inline void for_each_batch(const Range<T> &rng, Body &&body) {
+        detail::for_each_batch_impl<simd_width<T>>(rng, body);
+    }
+
+    /**
+     * @brief for_each_batch<W>(const StepRange<T> &rng, Body &&body)
+     *
+     * @tparam W lanes per batch
+     * @tparam T
+     * @tparam Body
+     * @param[in] rng
+     * @param[in] body
+     */
+    template <size_t W, typename T, typename Body>
+    inline void for_each_batch(const StepRange<T> &rng, Body &&body) {
+        detail::for_each_batch_impl<W>(rng, body);
+    }
+
+    /**
+     * @brief for_each_batch(const StepRange<T> &rng, Body &&body)
+     *
+     * @tparam T
+     * @tparam Body
+     * @param[in] rng
+     * @param[in] body
+     */
+    template <typename T, typename Body>
+    inline void for_each_batch(const StepRange<T> &rng, Body &&body) {
+        detail::for_each_batch_impl<simd_width<T>>(rng, body);
+    }
+
+    /**
+     * @brief for_each_batch<W>(enumerate(container), Body &&body)
+     *
+     * The `for_each_batch` function over `enumerate(container)` calls
+     * `body(idx, elem)` for every run of `W` consecutive elements of a
+     * contiguous container (one with `data()` and `size()`, such as
+     * `std::vector` and `std::array`). `idx` is a `Batch<Index, W>` with the
+     * indices (counted from the `start` of the enumeration) and `elem` a
+     * `BatchView` of the elements themselves. In the tail only the first
+     * `elem.size()` elements exist and may be accessed.
+     *
+     * @tparam W lanes per batch
+     * @tparam C
+     * @tparam Index
+     * @tparam Body
+     * @param[in] wrapper
+     * @param[in] body
+     */
+    template <size_t W, typename C, typename Index, typename Body>
+    inline auto for_each_batch(const detail::EnumerateIterableWrapper<C, Index> &wrapper,
+                               Body &&body) -> decltype(wrapper.base().data(), void()) {
+        using T = typename std::remove_reference<decltype(*wrapper.base().data())>::type;
+        auto *data = wrapper.base().data();
+        const auto n = static_cast<size_t>(wrapper.base().size());
+        const auto full = n - n % W;
+        auto idx = Batch<Index, W>{{}, W};
+        for (size_t k = 0; full != 0 && k != W; ++k) {
+            idx.lane[k] = static_cast<Index>(wrapper.start + k);
+        }
+        for (size_t base = 0; base != full; base += W) {
+            body(static_cast<const Batch<Index, W> &>(idx), BatchView<T, W>{data + base, W});
+            // no index past the end is computed, which could overflow `Index`
+            for (size_t k = 0; base + W != full && k != W; ++k) {
+                idx.lane[k] = static_cast<Index>(idx.lane[k] + W);
+            }
+        }
+        if (full != n) {
+            idx.count = n - full;
+            for (size_t k = 0; k != W; ++k) {
+                idx.lane[k] = static_cast<Index>(wrapper.start + full
+                                                 + (k < idx.count ? k : idx.count - 1));
+            }
+            body(static_cast<const Batch<Index, W> &>(idx),
+                 BatchView<T, W>{data + full, idx.count});
+        }
+    }
+
+    /**
+     * @brief for_each_batch(enumerate(container), Body &&body)
+     *
+     * Same as above, with `W` the SIMD width of the element type.
+     *
+     * @tparam C
+     * @tparam Index
+     * @tparam Body
+     * @param[in] wrapper
+     * @param[in] body
+     */
+    template <typename C, typename Index, typename Body>
+    inline auto for_each_batch(const detail::EnumerateIterableWrapper<C, Index> &wrapper,
+                               Body &&body) -> decltype(wrapper.base().data(), void()) {
+        using T = typename std::remove_reference<decltype(*wrapper.base().data())>::type;
+        for_each_batch<simd_width<T>>(wrapper, body);
+    }
+
+}  // namespace py
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstddef>      // import size_t
+#include <iterator>     // import std::random_access_iterator_tag
+#include <type_traits>  // import std::remove_pointer
+#include <utility>      // import std::declval
+
+#if defined(__cpp_lib_span)
+#    include <span>  // import std::span
+#endif
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // import std::ranges::enable_borrowed_range
+#endif
+
+#include "iterator.hpp"
+
+namespace py {
+
+    /**
+     * @brief Span
+     *
+     * A pointer and a length: a non-owning view of `size()` contiguous
+     * elements, the pre-C++20 stand-in for `std::span<T>`.
+     *
+     * @tparam T
+     */
+    template <typename T> struct Span {
+        using element_type = T;
+        using value_type = typename std::remove_cv<T>::type;
+        using iterator = T *;
+
+        T *ptr = nullptr;
+        size_t len = 0;
+
+        constexpr Span() = default;
+        constexpr Span(T *data, size_t size) : ptr(data), len(size) {}
+
+        constexpr auto data() const -> T * { return this->ptr; }
+        constexpr auto size() const -> size_t { return this->len; }
+        constexpr auto empty() const -> bool { return this->len == 0; }
+        constexpr auto begin() const -> T * { return this->ptr; }
+        constexpr auto end() const -> T * { return this->ptr + this->len; }
+        constexpr auto operator[](size_t k) const -> T & { return this->ptr[k]; }
+    };
+
+    /**
+     * @brief span<T>
+     *
+     * The view yielded by `chunks()` and `windows()`: `std::span<T>` when the
+     * standard library has it, `Span<T>` otherwise. Both have `data()`,
+     * `size()`, `begin()`, `end()` and `operator[]`.
+     *
+     * @tparam T
+     */
+#if defined(__cpp_lib_span)
+    template <typename T> using span = std::span<T>;
+#else
+    template <typename T> using span = Span<T>;
+#endif
+
+    namespace detail {
+
+        /**
+         * @brief SliceIterator
+         *
+         * The random-access iterator of `chunks()` and `windows()`. The `pos`-th
+         * view starts at `data + pos * stride` and has `width` elements, except
+         * that it is cut off at the end of the buffer (the tail chunk).
+         *
+         * @tparam T
+         * @tparam View constructible from a pointer and a length
+         */
+        template <typename T, typename View = span<T>>
+        struct SliceIterator : RandomAccessOps<SliceIterator<T, View>, View> {
+            using iterator_category = std::random_access_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = View;
+            using reference = View;
+            using pointer = void;
+
+            T *data = nullptr;
+            size_t size = 0;
+            size_t width = 0;
+            size_t stride = 0;
+            std::ptrdiff_t pos = 0;
+
+            constexpr SliceIterator() = default;
+            constexpr SliceIterator(T *data, size_t size, size_t width, size_t stride,
+                                    std::ptrdiff_t pos)
+                : data(data), size(size), width(width), stride(stride), pos(pos) {}
+
+            /**
+             * @brief
+             *
+             * @return reference
+             */
+            auto operator*() const -> reference {
+                const auto first = static_cast<size_t>(this->pos) * this->stride;
+                const auto rest = this->size - first;
+                return reference(this->data + first, rest < this->width ? rest : this->width);
+            }
+
+            CONSTEXPR14 void advance(difference_type n) { this->pos += n; }
+
+            constexpr auto distance_from(const SliceIterator &other) const -> difference_type {
+                return this->pos - other.pos;
+            }
+        };
+
+        /**
+         * @brief SliceView
+         *
+         * The range returned by `chunks()` and `windows()`. It refers to the
+         * buffer of the container, so the container must outlive it; the view
+         * itself is cheap to copy and can be split across threads by
+         * `parallel_for`.
+         *
+         * @tparam T
+         * @tparam View
+         */
+        template <typename T, typename View = span<T>> struct SliceView {
+            using iterator = SliceIterator<T, View>;
+            using value_type = View;
+
+            T *data;
+            size_t len;
+            size_t width;
+            size_t stride;
+            size_t count;  // number of views
+
+            /**
+             * @brief begin
+             *
+             * @return iterator
+             */
+            auto begin() const -> iterator {
+                return iterator{this->data, this->len, this->width, this->stride, 0};
+            }
+
+            /**
+             * @brief end
+             *
+             * @return iterator
+             */
+            auto end() const -> iterator {
+                return iterator{this->data, this->len, this->width, this->stride,
+                                static_cast<std::ptrdiff_t>(this->count)};
+            }
+
+            /**
+             * @brief size
+             *
+             * Returns the number of views.
+             *
+             * @return size_t
+             */
+            auto size() const -> size_t { return this->count; }
+
+            /**
+             * @brief empty
+             *
+             * @return true
+             * @return false
+             */
+            auto empty() const -> bool { return this->count == 0; }
+
+            /**
+             * @brief
+             *
+             * @param[in] n
+             * @return View
+             */
+            auto operator[](size_t n) const -> View {
+                return this->begin()[static_cast<std::ptrdiff_t>(n)];
+            }
+        };
+
+        template <typename C> using slice_element_t =
+            typename std::remove_pointer<decltype(std::declval<C &>().data())>::type;
+
+    }  // namespace detail
+
+    /**
+     * @brief chunks(container, k)
+     *
+     * The `chunks()` function splits a contiguous container (one with `data()`
+     * and `size()`) into consecutive chunks of `k` elements, like Python's
+     * `itertools.batched`. The last chunk holds the remaining `size() % k`
+     * elements if `k` does not divide the size. The chunks are `span`s into the
+     * container, nothing is copied. The view is random access, so it can be
+     * passed to `parallel_for` or `enumerate()` (which numbers the chunks). A
+     * zero `k` yields no chunks.
+     *
+     * @tparam C
+     * @param[in] container
+     * @param[in] k
+     * @return detail::SliceView<detail::slice_element_t<C>>
+     */
+    template <typename C>
+    inline auto chunks(C &container, size_t k) -> detail::SliceView<detail::slice_element_t<C>> {
+        const auto n = static_cast<size_t>(container.size());
+        const auto count = k == 0 ? 0 : (n + k - 1) / k;
+        return {container.data(), n, k, k, count};
+    }
+
+    /**
+     * @brief windows(container, k)
+     *
+     * The `windows()` function yields every run of `k` consecutive elements of
+     * a contiguous container, as `span`s: `[0, k)`, `[1, k + 1)`, ... There are
+     * `size() - k + 1` windows, and none if the container has fewer than `k`
+     * elements or `k` is zero.
+     *
+     * @tparam C
+     * @param[in] container
+     * @param[in] k
+     * @return detail::SliceView<detail::slice_element_t<C>>
+     */
+    template <typename C>
+    inline auto windows(C &container, size_t k) -> detail::SliceView<detail::slice_element_t<C>> {
+        const auto n = static_cast<size_t>(container.size());
+        const auto count = k == 0 || k > n ? 0 : n - k + 1;
+        return {container.data(), n, k, 1, count};
+    }
+
+}  // namespace py
+
+#if defined(__cpp_lib_ranges)
+
+// A slice view only refers to the buffer of its container, so it is a borrowed
+// view.
+namespace std::ranges {
+    template <typename T, typename View>
+    inline constexpr bool enable_borrowed_range<py::detail::SliceView<T, View>> = true;
+
+    template <typename T, typename View>
+    inline constexpr bool enable_view<py::detail::SliceView<T, View>> = true;
+}  // namespace std::ranges
+
+#endif
@@ -0,0 +1,492 @@
+#pragma once
+
+#include <array>      // import std::array
+#include <cstddef>    // import size_t
+#include <cstdint>    // import uint64_t
+#include <iterator>
+#include <stdexcept>  // import std::length_error
+#include <string>     // import std::to_string
+
+#include "range.hpp"
+
+#if defined(__BMI2__)
+#    include <immintrin.h>  // import _pdep_u64 _pext_u64
+#endif
+
+namespace py {
+
+    namespace detail {
+
+        /**
+         * @brief morton_mask<N>
+         *
+         * Every N-th bit set, starting at bit 0: the positions that one coordinate
+         * occupies in an N-dimensional Morton code.
+         *
+         * @tparam N
+         */
+        template <size_t N> struct morton_mask;
+
+        template <> struct morton_mask<2> {
+            static constexpr std::uint64_t value = 0x5555555555555555ULL;
+        };
+
+        template <> struct morton_mask<3> {
+            static constexpr std::uint64_t value = 0x1249249249249249ULL;
+        };
+
+#if defined(__BMI2__)
+        template <size_t N> inline auto morton_compact(std::uint64_t code) -> std::uint64_t {
+            return _pext_u64(code, morton_mask<N>::value);
+        }
+
+        template <size_t N> inline auto morton_spread(std::uint64_t x) -> std::uint64_t {
+            return _pdep_u64(x, morton_mask<N>::value);
+        }
+#else
+        template <size_t N> inline auto morton_compact(std::uint64_t code) -> std::uint64_t;
+
+        template <> inline auto morton_compact<2>(std::uint64_t x) -> std::uint64_t {
+            x &= 0x5555555555555555ULL;
+            x = (x | (x >> 1)) & 0x3333333333333333ULL;
+            x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+            x = (x | (x >> 4)) & 0x00ff00ff00ff00ffULL;
+            x = (x | (x >> 8)) & 0x0000ffff0000ffffULL;
+            x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+            return x;
+        }
+
+        template <> inline auto morton_compact<3>(std::uint64_t x) -> std::uint64_t {
+            x &= 0x1249249249249249ULL;
+            x = (x | (x >> 2)) & 0x10c30c30c30c30c3ULL;
+            x = (x | (x >> 4)) & 0x100f00f00f00f00fULL;
+            x = (x | (x >> 8)) & 0x001f0000ff0000ffULL;
+            x = (x | (x >> 16)) & 0x001f00000000ffffULL;
+            x = (x | (x >> 32)) & 0x00000000001fffffULL;
+            return x;
+        }
+
+        template <size_t N> inline auto morton_spread(std::uint64_t x) -> std::uint64_t;
+
+        template <> inline auto morton_spread<2>(std::uint64_t x) -> std::uint64_t {
+            x &= 0x00000000ffffffffULL;
+            x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+            x = (x | (x << 8)) & 0x00ff00ff00ff00ffULL;
+            x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            x = (x | (x << 2)) & 0x3333333333333333ULL;
+            x = (x | (x << 1)) & 0x5555555555555555ULL;
+            return x;
+        }
+
+        template <> inline auto morton_spread<3>(std::uint64_t x) -> std::uint64_t {
+            x &= 0x00000000001fffffULL;
+            x = (x | (x << 32)) & 0x001f00000000ffffULL;
+            x = (x | (x << 16)) & 0x001f0000ff0000ffULL;
+            x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+            x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+            x = (x | (x << 2)) & 0x1249249249249249ULL;
+            return x;
+        }
+#endif
+
+    }  // namespace detail
+
+    /**
+     * @brief ZOrder
+     *
+     * Z-order (Morton) curve: the curve index is the bitwise interleaving of the
+     * coordinates, with bit `j` of coordinate `d` at position `N * j + d`.
+     */
+    struct ZOrder {
+        template <size_t N>
+        static auto decode(std::uint64_t code, unsigned /* bits */)
+            -> std::array<std::uint64_t, N> {
+            auto coord = std::array<std::uint64_t, N>{};
+            for (size_t d = 0; d != N; ++d) {
+                coord[d] = detail::morton_compact<N>(code >> d);
+            }
+            return coord;
+        }
+
+        template <size_t N>
+        static auto encode(std::array<std::uint64_t, N> coord, unsigned /* bits */)
+            -> std::uint64_t {
+            auto code = std::uint64_t(0);
+            for (size_t d = 0; d != N; ++d) {
+                code |= detail::morton_spread<N>(coord[d]) << d;
+            }
+            return code;
+        }
+    };
+
+    /**
+     * @brief HilbertOrder
+     *
+     * Hilbert curve, computed with Skilling's algorithm ("Programming the Hilbert
+     * curve", AIP Conf. Proc. 707, 2004): the curve index is first de-interleaved
+     * like a Morton code (the "transposed" Hilbert index), which is then turned
+     * into coordinates by a Gray decode and a sequence of bit swaps and flips.
+     * Consecutive indices are always neighbouring cells.
+     */
+    struct HilbertOrder {
+        template <size_t N>
+        static auto decode(std::uint64_t code, unsigned bits) -> std::array<std::uint64_t, N> {
+            // transposed index: X[0] holds the most significant bit of each group
+            auto X = std::array<std::uint64_t, N>{};
+            for (size_t i = 0; i != N; ++i) {
+                X[i] = detail::morton_compact<N>(code >> (N - 1 - i));
+            }
+            // Gray decode
+            const auto t = X[N - 1] >> 1;
+            for (size_t i = N - 1; i != 0; --i) {
+                X[i] ^= X[i - 1];
+            }
+            X[0] ^= t;
+            // undo excess work
+            const auto side = std::uint64_t(1) << bits;
+            for (auto Q = std::uint64_t(2); Q < side; Q <<= 1) {
+                const auto P = Q - 1;
+                for (size_t i = N; i-- != 0;) {
+                    if ((X[i] & Q) != 0) {
+                        X[0] ^= P;  // invert
+                    } else {
+                        const auto s = (X[0] ^ X[i]) & P;  // exchange
+                        X[0] ^= s;
+                        X[i] ^= s;
+                    }
+                }
+            }
+            return X;
+        }
+
+        template <size_t N>
+        static auto encode(std::array<std::uint64_t, N> X, unsigned bits) -> std::uint64_t {
+            const auto M = std::uint64_t(1) << (bits - 1);
+            // inverse undo
+            for (auto Q = M; Q > 1; Q >>= 1) {
+                const auto P = Q - 1;
+                for (size_t i = 0; i != N; ++i) {
+                    if ((X[i] & Q) != 0) {
+                        X[0] ^= P;  // invert
+                    } else {
+                        const auto s = (X[0] ^ X[i]) & P;  // exchange
+                        X[0] ^= s;
+                        X[i] ^= s;
+                    }
+                }
+            }
+            // Gray encode
+            for (size_t i = 1; i != N; ++i) {
+                X[i] ^= X[i - 1];
+            }
+            auto t = std::uint64_t(0);
+            for (auto Q = M; Q > 1; Q >>= 1) {
+                if ((X[N - 1] & Q) != 0) {
+                    t ^= Q - 1;
+                }
+            }
+            auto code = std::uint64_t(0);
+            for (size_t i = 0; i != N; ++i) {
+                code |= detail::morton_spread<N>(X[i] ^ t) << (N - 1 - i);
+            }
+            return code;
+        }
+    };
+
+    template <typename T, size_t N, typename Order> struct CurveRange;
+
+    /**
+     * @brief CurveIterator
+     *
+     * The `CurveIterator` struct visits the Cartesian product of `N` ranges in the
+     * order of a space-filling curve. It keeps only the current curve index and
+     * decodes the coordinates from it, so no index table is allocated.
+     *
+     * The curve covers a cube of side `2^bits` that encloses the ranges. Both the
+     * Z-order and the Hilbert curve map every aligned block of `2^(N * j)`
+     * consecutive indices onto an aligned cube of side `2^j`, so when a decoded
+     * point lies outside the ranges the iterator jumps over the largest such cube
+     * that lies completely outside, instead of testing its points one by one.
+     * This keeps the overhead for extents that are not powers of two small.
+     *
+     * @tparam T
+     * @tparam N
+     * @tparam Order `ZOrder` or `HilbertOrder`
+     */
+    template <typename T, size_t N, typename Order> struct CurveIterator {
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::array<T, N>;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        CurveRange<T, N, Order> rng;
+        std::uint64_t code;  // current curve index
+        value_type idx;      // current index tuple
+
+        /**
+         * @brief Not equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        auto operator!=(const CurveIterator &other) const -> bool {
+            return this->code != other.code;
+        }
+
+        /**
+         * @brief Equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        auto operator==(const CurveIterator &other) const -> bool {
+            return this->code == other.code;
+        }
+
+        /**
+         * @brief
+         *
+         * Returns the current index tuple.
+         *
+         * @return reference
+         */
+        auto operator*() const -> reference { return this->idx; }
+
+        /**
+         * @brief curve_index
+         *
+         * Returns the position of the current tuple on the (enclosing) curve.
+         *
+         * @return std::uint64_t
+         */
+        auto curve_index() const -> std::uint64_t { return this->code; }
+
+        /**
+         * @brief
+         *
+         * @return CurveIterator&
+         */
+        auto operator++() -> CurveIterator & {
+            ++this->code;
+            this->settle();
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * @return CurveIterator
+         */
+        auto operator++(int) -> CurveIterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        /**
+         * @brief settle
+         *
+         * Advances `code` to the first curve index at or after it whose point
+         * lies inside the ranges, and decodes that point into `idx`.
+         */
+        void settle() {
+            while (this->code != this->rng.code_end) {
+                const auto coord = Order::template decode<N>(this->code, this->rng.bits);
+                auto outside = false;
+                auto skip = 0U;  // level of the largest cube that lies outside
+                for (size_t d = 0; d != N; ++d) {
+                    if (coord[d] < this->rng.extent[d]) {
+                        continue;
+                    }
+                    outside = true;
+                    for (auto j = this->rng.bits; j > skip; --j) {
+                        if ((coord[d] >> j << j) >= this->rng.extent[d]) {
+                            skip = j;
+                            break;
+                        }
+                    }
+                }
+                if (!outside) {
+                    for (size_t d = 0; d != N; ++d) {
+                        this->idx[d] = this->rng.dims[d][coord[d]];
+                    }
+                    return;
+                }
+                const auto shift = N * skip;
+                this->code = ((this->code >> shift) + 1) << shift;
+            }
+        }
+    };
+
+    /**
+     * @brief CurveRange
+     *
+     * The `CurveRange` struct represents the Cartesian product of two or three
+     * ranges `Range<T>`, traversed along a space-filling curve (`ZOrder` or
+     * `HilbertOrder`). Neighbouring steps of the curve are close in every
+     * dimension, so blocks of every size are visited together and the traversal
+     * is cache- and TLB-friendly without a tile size that has to be tuned to the
+     * problem.
+     *
+     * @tparam T
+     * @tparam N
+     * @tparam Order
+     */
+    template <typename T, size_t N, typename Order> struct CurveRange {
+        static_assert(N == 2 || N == 3, "space-filling curves are provided for 2D and 3D");
+
+        using iterator = CurveIterator<T, N, Order>;
+        using value_type = std::array<T, N>;
+
+        // the curve index must fit in 64 bits: 2D up to 2^31, 3D up to 2^21 per dimension
+        static constexpr unsigned max_bits = 63 / N;
+
+        std::array<Range<T>, N> dims;
+        std::array<std::uint64_t, N> extent;
+        unsigned bits;           // the curve covers a cube of side 2^bits
+        std::uint64_t code_end;  // 2^(N * bits), or 0 if a range is empty
+
+        /**
+         * @brief Construct a new CurveRange object
+         *
+         * Every extent must be at most `2^max_bits`; larger ones would shift past
+         * the width of the curve index.
+         *
+         * @param[in] dims
+         * @throw std::length_error if an extent exceeds `2^max_bits`
+         */
+        explicit CurveRange(const std::array<Range<T>, N> &dims) : dims(dims), extent{}, bits(1) {
+            auto empty = false;
+            for (size_t d = 0; d != N; ++d) {
+                this->extent[d] = dims[d].size();
+                empty = empty || dims[d].empty();
+                while (this->bits < max_bits
+                       && (std::uint64_t(1) << this->bits) < this->extent[d]) {
+                    ++this->bits;
+                }
+                if (this->extent[d] > std::uint64_t(1) << this->bits) {
+                    throw std::length_error("space-filling curve extent exceeds 2^"
+                                            + std::to_string(max_bits));
+                }
+            }
+            this->code_end = empty ? 0 : std::uint64_t(1) << (N * this->bits);
+        }
+
+        /**
+         * @brief begin
+         *
+         * @return iterator
+         */
+        auto begin() const -> iterator {
+            auto it = iterator{*this, 0, {}};
+            it.settle();
+            return it;
+        }
+
+        /**
+         * @brief end
+         *
+         * @return iterator
+         */
+        auto end() const -> iterator { return iterator{*this, this->code_end, {}}; }
+
+        /**
+         * @brief empty
+         *
+         * @return true
+         * @return false
+         */
+        auto empty() const -> bool { return this->code_end == 0; }
+
+        /**
+         * @brief size
+         *
+         * @return size_t
+         */
+        auto size() const -> size_t {
+            auto n = size_t(1);
+            for (const auto &dim : this->dims) {
+                n *= dim.size();
+            }
+            return n;
+        }
+
+        /**
+         * @brief contains
+         *
+         * @param[in] idx
+         * @return true
+         * @return false
+         */
+        auto contains(const value_type &idx) const -> bool {
+            for (size_t d = 0; d != N; ++d) {
+                if (!this->dims[d].contains(idx[d])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief curve_index
+         *
+         * Returns the position of `idx` on the curve; tuples with a smaller curve
+         * index are visited first.
+         *
+         * @param[in] idx
+         * @return std::uint64_t
+         */
+        auto curve_index(const value_type &idx) const -> std::uint64_t {
+            auto coord = std::array<std::uint64_t, N>{};
+            for (size_t d = 0; d != N; ++d) {
+                coord[d] = static_cast<std::uint64_t>(
+                    detail::range_distance(this->dims[d].start, idx[d]));
+            }
+            return Order::template encode<N>(coord, this->bits);
+        }
+    };
+
+    /**
+     * @brief morton(Range<T> first, Range<T>... rest)
+     *
+     * Returns the Cartesian product of two or three ranges in Z-order (Morton
+     * order). Each range may hold up to `2^31` values in 2D and `2^21` in 3D;
+     * a longer one throws `std::length_error`.
+     *
+     * @tparam T
+     * @tparam Rngs
+     * @param[in] first
+     * @param[in] rest
+     * @return CurveRange<T, 1 + sizeof...(Rngs), ZOrder>
+     * @throw std::length_error if a range is too long for the curve index
+     */
+    template <typename T, typename... Rngs>
+    inline auto morton(const Range<T> &first, const Rngs &...rest)
+        -> CurveRange<T, 1 + sizeof...(Rngs), ZOrder> {
+        return CurveRange<T, 1 + sizeof...(Rngs), ZOrder>{{{first, rest...}}};
+    }
+
+    /**
+     * @brief hilbert(Range<T> first, Range<T>... rest)
+     *
+     * Returns the Cartesian product of two or three ranges in Hilbert order.
+     * Each range may hold up to `2^31` values in 2D and `2^21` in 3D; a longer
+     * one throws `std::length_error`.
+     *
+     * @tparam T
+     * @tparam Rngs
+     * @param[in] first
+     * @param[in] rest
+     * @return CurveRange<T, 1 + sizeof...(Rngs), HilbertOrder>
+     * @throw std::length_error if a range is too long for the curve index
+     */
+    template <typename T, typename... Rngs>
+    inline auto hilbert(const Range<T> &first, const Rngs &...rest)
+        -> CurveRange<T, 1 + sizeof...(Rngs), HilbertOrder> {
+        return CurveRange<T, 1 + sizeof...(Rngs), HilbertOrder>{{{first, rest...}}};
+    }
+
+}  // namespace py
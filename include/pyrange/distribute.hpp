@@ -0,0 +1,325 @@
+#pragma once
+
+#include <cstddef>   // import size_t
+#include <iterator>  // import std::random_access_iterator_tag
+
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // import std::ranges::enable_borrowed_range
+#endif
+
+#include "iterator.hpp"
+#include "range.hpp"
+
+namespace py {
+
+    /**
+     * @brief Block
+     *
+     * Distribution policy: every rank gets one contiguous part. The sizes
+     * differ by at most one; the first `n % nranks` ranks get the larger parts.
+     */
+    struct Block {};
+
+    /**
+     * @brief Cyclic
+     *
+     * Distribution policy: element `i` goes to rank `i % nranks`, so every rank
+     * gets a strided part of the range.
+     */
+    struct Cyclic {};
+
+    /**
+     * @brief BlockCyclic
+     *
+     * Distribution policy: the range is cut into blocks of `k` elements (the
+     * last one may be shorter), which are dealt to the ranks in turn: block `b`
+     * goes to rank `b % nranks`. `BlockCyclic{1}` is `Cyclic`, and `BlockCyclic`
+     * with `k >= ceil(n / nranks)` is a blocked distribution in which only the
+     * last part is short. `k` must be positive.
+     */
+    struct BlockCyclic {
+        size_t k;
+    };
+
+    /**
+     * @brief BlockCyclicIterator
+     *
+     * The random-access iterator of a `BlockCyclicRange`. Stepping forward
+     * walks through the current block and jumps over the blocks of the other
+     * ranks at its end, without a division.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    struct BlockCyclicIterator : detail::RandomAccessOps<BlockCyclicIterator<T>, T> {
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = void;
+        using reference = T;
+
+        Range<T> whole{};
+        size_t k = 1;
+        size_t nranks = 1;
+        size_t rank = 0;
+        size_t pos = 0;       // local index
+        size_t index = 0;     // global index of `pos`
+        size_t in_block = 0;  // `index % k`
+
+        constexpr BlockCyclicIterator() = default;
+        constexpr BlockCyclicIterator(Range<T> whole, size_t k, size_t nranks, size_t rank)
+            : whole(whole), k(k), nranks(nranks), rank(rank), index(rank * k) {}
+
+        constexpr auto operator*() const -> T { return this->whole[this->index]; }
+
+        CONSTEXPR14 void increment() {
+            ++this->pos;
+            ++this->index;
+            if (++this->in_block == this->k) {
+                this->in_block = 0;
+                this->index += (this->nranks - 1) * this->k;
+            }
+        }
+
+        CONSTEXPR14 void advance(difference_type n) {
+            this->pos = static_cast<size_t>(static_cast<difference_type>(this->pos) + n);
+            this->in_block = this->pos % this->k;
+            this->index = (this->pos / this->k * this->nranks + this->rank) * this->k
+                          + this->in_block;
+        }
+
+        constexpr auto distance_from(const BlockCyclicIterator &other) const -> difference_type {
+            return static_cast<difference_type>(this->pos)
+                   - static_cast<difference_type>(other.pos);
+        }
+    };
+
+    /**
+     * @brief BlockCyclicRange
+     *
+     * The part of a `Range` that one rank owns under `BlockCyclic`: its blocks
+     * number `rank`, `rank + nranks`, `rank + 2 * nranks`, ...
+     *
+     * @tparam T
+     */
+    template <typename T> struct BlockCyclicRange {
+        using iterator = BlockCyclicIterator<T>;
+        using value_type = T;
+
+        Range<T> whole;
+        size_t k;
+        size_t nranks;
+        size_t rank;
+        size_t len;
+
+        auto begin() const -> iterator {
+            return iterator{this->whole, this->k, this->nranks, this->rank};
+        }
+
+        auto end() const -> iterator {
+            return this->begin() + static_cast<std::ptrdiff_t>(this->len);
+        }
+
+        constexpr auto size() const -> size_t { return this->len; }
+
+        constexpr auto empty() const -> bool { return this->len == 0; }
+
+        /**
+         * @brief
+         *
+         * Returns the element with local index `j`.
+         *
+         * @param[in] j
+         * @return T
+         */
+        constexpr auto operator[](size_t j) const -> T {
+            return this->whole[(j / this->k * this->nranks + this->rank) * this->k + j % this->k];
+        }  // no bounds checking
+
+        /**
+         * @brief
+         *
+         * @param[in] x
+         * @return true
+         * @return false
+         */
+        constexpr auto contains(T x) const -> bool {
+            return this->whole.contains(x)
+                   && static_cast<size_t>(x - this->whole.start) / this->k % this->nranks
+                          == this->rank;
+        }
+    };
+
+    /**
+     * @brief Distribution
+     *
+     * The `Distribution` struct describes how the indices `0 .. n - 1` of a
+     * `Range` are spread over `nranks` ranks under a policy. Every query is
+     * O(1): `part(rank)` is the subrange of a rank, `owner(i)` the rank that
+     * owns global index `i`, `local(i)` the position of `i` within the part of
+     * its owner and `global(rank, j)` the global index of the `j`-th element of
+     * a part. The element itself is `range[i]`.
+     *
+     * @tparam T
+     * @tparam Policy
+     */
+    template <typename T, typename Policy> struct Distribution;
+
+    template <typename T> struct Distribution<T, Block> {
+        Range<T> range;
+        size_t nranks;
+
+        // the first `rem` parts have `quot + 1` elements, the others `quot`
+        constexpr auto quot() const -> size_t { return this->range.size() / this->nranks; }
+        constexpr auto rem() const -> size_t { return this->range.size() % this->nranks; }
+
+        /**
+         * @brief first
+         *
+         * Returns the global index of the first element of the part of `rank`.
+         *
+         * @param[in] rank
+         * @return size_t
+         */
+        constexpr auto first(size_t rank) const -> size_t {
+            return rank * this->quot() + (rank < this->rem() ? rank : this->rem());
+        }
+
+        constexpr auto part(size_t rank) const -> Range<T> {
+            return Range<T>{this->range[this->first(rank)], this->range[this->first(rank + 1)]};
+        }
+
+        constexpr auto owner(size_t i) const -> size_t {
+            return i < this->rem() * (this->quot() + 1)
+                       ? i / (this->quot() + 1)
+                       : this->rem() + (i - this->rem() * (this->quot() + 1)) / this->quot();
+        }
+
+        constexpr auto local(size_t i) const -> size_t { return i - this->first(this->owner(i)); }
+
+        constexpr auto global(size_t rank, size_t j) const -> size_t {
+            return this->first(rank) + j;
+        }
+    };
+
+    template <typename T> struct Distribution<T, Cyclic> {
+        Range<T> range;
+        size_t nranks;
+
+        CONSTEXPR14 auto part(size_t rank) const -> StepRange<T> {
+            using step_type = typename StepRange<T>::step_type;
+            const auto n = this->range.size();
+            const auto len = rank < n ? (n - rank - 1) / this->nranks + 1 : 0;
+            return StepRange<T>{rank < n ? this->range[rank] : this->range.start,
+                                static_cast<step_type>(this->nranks),
+                                static_cast<step_type>(len)};
+        }
+
+        constexpr auto owner(size_t i) const -> size_t { return i % this->nranks; }
+
+        constexpr auto local(size_t i) const -> size_t { return i / this->nranks; }
+
+        constexpr auto global(size_t rank, size_t j) const -> size_t {
+            return j * this->nranks + rank;
+        }
+    };
+
+    template <typename T> struct Distribution<T, BlockCyclic> {
+        Range<T> range;
+        size_t nranks;
+        BlockCyclic policy;
+
+        CONSTEXPR14 auto part(size_t rank) const -> BlockCyclicRange<T> {
+            const auto n = this->range.size();
+            const auto k = this->policy.k;
+            const auto blocks = (n + k - 1) / k;
+            auto len = size_t(0);
+            if (rank < blocks) {
+                len = ((blocks - rank - 1) / this->nranks + 1) * k;
+                if ((blocks - 1) % this->nranks == rank) {
+                    len -= blocks * k - n;  // the last block is short
+                }
+            }
+            return BlockCyclicRange<T>{this->range, k, this->nranks, rank, len};
+        }
+
+        constexpr auto owner(size_t i) const -> size_t {
+            return i / this->policy.k % this->nranks;
+        }
+
+        constexpr auto local(size_t i) const -> size_t {
+            return i / this->policy.k / this->nranks * this->policy.k + i % this->policy.k;
+        }
+
+        constexpr auto global(size_t rank, size_t j) const -> size_t {
+            return (j / this->policy.k * this->nranks + rank) * this->policy.k
+                   + j % this->policy.k;
+        }
+    };
+
+    /**
+     * @brief distribution(rng, nranks, policy)
+     *
+     * Describes the distribution of `rng` over `nranks` ranks (`nranks > 0`).
+     *
+     * @tparam T
+     * @tparam Policy `Block`, `Cyclic` or `BlockCyclic`
+     * @param[in] rng
+     * @param[in] nranks
+     * @param[in] policy
+     * @return Distribution<T, Policy>
+     */
+    template <typename T> constexpr auto distribution(const Range<T> &rng, size_t nranks, Block)
+        -> Distribution<T, Block> {
+        return Distribution<T, Block>{rng, nranks};
+    }
+
+    template <typename T> constexpr auto distribution(const Range<T> &rng, size_t nranks, Cyclic)
+        -> Distribution<T, Cyclic> {
+        return Distribution<T, Cyclic>{rng, nranks};
+    }
+
+    template <typename T>
+    constexpr auto distribution(const Range<T> &rng, size_t nranks, BlockCyclic policy)
+        -> Distribution<T, BlockCyclic> {
+        return Distribution<T, BlockCyclic>{rng, nranks, policy};
+    }
+
+    /**
+     * @brief distribute(rng, rank, nranks, policy)
+     *
+     * Returns the part of `rng` that `rank` of `nranks` owns under `policy`: a
+     * `Range` for `Block`, a `StepRange` for `Cyclic` and a `BlockCyclicRange`
+     * for `BlockCyclic`. The parts of all ranks cover every element of `rng`
+     * exactly once. Typical use, with `rank` and `nranks` taken from MPI or
+     * from a thread id:
+     *
+     *     for (auto i : py::distribute(py::range(n), rank, nranks, py::Block{}))
+     *
+     * @tparam T
+     * @tparam Policy
+     * @param[in] rng
+     * @param[in] rank
+     * @param[in] nranks
+     * @param[in] policy
+     */
+    template <typename T, typename Policy>
+    CONSTEXPR14 auto distribute(const Range<T> &rng, size_t rank, size_t nranks, Policy policy)
+        -> decltype(distribution(rng, nranks, policy).part(rank)) {
+        return distribution(rng, nranks, policy).part(rank);
+    }
+
+}  // namespace py
+
+#if defined(__cpp_lib_ranges)
+
+// A block-cyclic part holds the whole range by value and no storage, so it is a
+// borrowed view.
+namespace std::ranges {
+    template <typename T>
+    inline constexpr bool enable_borrowed_range<py::BlockCyclicRange<T>> = true;
+
+    template <typename T> inline constexpr bool enable_view<py::BlockCyclicRange<T>> = true;
+}  // namespace std::ranges
+
+#endif
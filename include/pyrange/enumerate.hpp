@@ -1,10 +1,15 @@
 #pragma once
 
-#include <cstddef>   // import size_t
-#include <iterator>  // import std::begin() std::end()
+#include <cstddef>     // import size_t
+#include <functional>  // import std::reference_wrapper
+#include <iterator>    // import std::begin() std::end()
 #include <type_traits>
 #include <utility>
 
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // import std::ranges::enable_view, std::ranges::enable_borrowed_range
+#endif
+
 namespace py {
 
     namespace detail {
@@ -16,14 +21,27 @@ namespace py {
          * over a container or range and provide the index of each element in the
          * iteration.
          *
-         * @tparam T
+         * The iterator has the category of the underlying iterator `Iter`, up to
+         * random access: over a random-access iterator it supports index arithmetic
+         * and can be handed to the parallel algorithms of the standard library.
+         * Iterators are compared by their underlying iterator only. The index is
+         * a counter of type `Index` that is stepped along with the iterator; a
+         * 32-bit `Index` keeps the index arithmetic at the width of 32-bit
+         * elements in vectorized loops.
+         *
+         * @tparam Iter the iterator of the underlying range
+         * @tparam Index the type of the index
          */
-        template <typename T> struct EnumerateIterator {
-            typedef decltype(std::begin(std::declval<T>())) TIter;
-            using iter_ref = typename std::iterator_traits<TIter>::reference;
+        template <typename Iter, typename Index = size_t> struct EnumerateIterator {
+            using iter_ref = decltype(*std::declval<const Iter &>());
+            using iterator_category = typename std::iterator_traits<Iter>::iterator_category;
+            using difference_type = typename std::iterator_traits<Iter>::difference_type;
+            using value_type = std::pair<Index, typename std::iterator_traits<Iter>::value_type>;
+            using reference = std::pair<Index, iter_ref>;
+            using pointer = void;
 
-            size_t i;
-            TIter iter;
+            Index i;
+            Iter iter;
 
             /**
              * @brief Not equal to
@@ -43,6 +61,17 @@ namespace py {
                 return iter != other.iter;
             }
 
+            /**
+             * @brief Equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator==(const EnumerateIterator &other) const -> bool {
+                return iter == other.iter;
+            }
+
             /**
              * @brief
              *
@@ -60,23 +89,273 @@ namespace py {
                 return *this;
             }
 
+            /**
+             * @brief
+             *
+             * The post-increment operator, which returns a copy of the iterator
+             * before the increment.
+             *
+             * @return EnumerateIterator
+             */
+            auto operator++(int) -> EnumerateIterator {
+                auto temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            /**
+             * @brief
+             *
+             * The pre-decrement operator, for bidirectional underlying iterators.
+             *
+             * @return EnumerateIterator&
+             */
+            auto operator--() -> EnumerateIterator & {
+                --i;
+                --iter;
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * The post-decrement operator, which returns a copy of the iterator
+             * before the decrement.
+             *
+             * @return EnumerateIterator
+             */
+            auto operator--(int) -> EnumerateIterator {
+                auto temp = *this;
+                --(*this);
+                return temp;
+            }
+
             /**
              * @brief
              *
              * The `operator*()` function is an overloaded operator that returns the
-             * current element in the iteration as a `std::pair<size_t, iter_ref>`. The
-             * `size_t` value represents the index of the element, and the `iter_ref`
+             * current element in the iteration as a `std::pair<Index, iter_ref>`. The
+             * `Index` value represents the index of the element, and the `iter_ref`
              * value represents a reference to the element itself. This allows you to
              * access both the index and the element in a single expression when using
              * the `enumerate()` function.
              *
-             * @return std::pair<size_t, iter_ref>
+             * @return std::pair<Index, iter_ref>
+             */
+            auto operator*() const -> reference { return reference{i, *iter}; }
+
+            /**
+             * @brief
+             *
+             * Advances the index and the underlying iterator by `n` elements. The
+             * following operators are only available over random-access iterators.
+             *
+             * @param[in] n
+             * @return EnumerateIterator&
+             */
+            auto operator+=(difference_type n) -> EnumerateIterator & {
+                i = static_cast<Index>(i + n);
+                iter += n;
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * @param[in] n
+             * @return EnumerateIterator&
+             */
+            auto operator-=(difference_type n) -> EnumerateIterator & {
+                i = static_cast<Index>(i - n);
+                iter -= n;
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * Returns a copy of the iterator advanced by `n` elements.
+             *
+             * @param[in] n
+             * @return EnumerateIterator
+             */
+            auto operator+(difference_type n) const -> EnumerateIterator {
+                auto temp = *this;
+                return temp += n;
+            }
+
+            /**
+             * @brief
+             *
+             * @param[in] n
+             * @param[in] it
+             * @return EnumerateIterator
+             */
+            friend auto operator+(difference_type n, const EnumerateIterator &it)
+                -> EnumerateIterator {
+                return it + n;
+            }
+
+            /**
+             * @brief
+             *
+             * Returns a copy of the iterator moved back by `n` elements.
+             *
+             * @param[in] n
+             * @return EnumerateIterator
+             */
+            auto operator-(difference_type n) const -> EnumerateIterator {
+                auto temp = *this;
+                return temp -= n;
+            }
+
+            /**
+             * @brief
+             *
+             * Returns the number of elements between `other` and the current
+             * iterator.
+             *
+             * @param[in] other
+             * @return difference_type
+             */
+            auto operator-(const EnumerateIterator &other) const -> difference_type {
+                return iter - other.iter;
+            }
+
+            /**
+             * @brief
+             *
+             * Returns the index and element `n` elements past the current iterator.
+             *
+             * @param[in] n
+             * @return std::pair<Index, iter_ref>
+             */
+            auto operator[](difference_type n) const -> reference { return *(*this + n); }
+
+            /**
+             * @brief Less than
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator<(const EnumerateIterator &other) const -> bool {
+                return iter < other.iter;
+            }
+
+            /**
+             * @brief Greater than
+             *
+             * @param[in] other
+             * @return true
+             * @return false
              */
-            auto operator*() -> std::pair<size_t, iter_ref> {
-                return std::pair<size_t, iter_ref>{i, *iter};
+            auto operator>(const EnumerateIterator &other) const -> bool {
+                return other.iter < iter;
+            }
+
+            /**
+             * @brief Less than or equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator<=(const EnumerateIterator &other) const -> bool {
+                return !(other.iter < iter);
+            }
+
+            /**
+             * @brief Greater than or equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator>=(const EnumerateIterator &other) const -> bool {
+                return !(iter < other.iter);
+            }
+        };
+
+        /**
+         * @brief EnumerateSentinel
+         *
+         * The end of an enumeration over a range whose `end()` returns a sentinel
+         * of another type than its iterator. It compares equal to an
+         * `EnumerateIterator` whose underlying iterator equals the sentinel.
+         *
+         * @tparam Sent the sentinel of the underlying range
+         */
+        template <typename Sent> struct EnumerateSentinel {
+            Sent end;
+
+            template <typename Iter, typename Index>
+            friend auto operator==(const EnumerateIterator<Iter, Index> &it,
+                                   const EnumerateSentinel &s) -> bool {
+                return it.iter == s.end;
+            }
+
+            template <typename Iter, typename Index>
+            friend auto operator==(const EnumerateSentinel &s,
+                                   const EnumerateIterator<Iter, Index> &it) -> bool {
+                return it.iter == s.end;
+            }
+
+            template <typename Iter, typename Index>
+            friend auto operator!=(const EnumerateIterator<Iter, Index> &it,
+                                   const EnumerateSentinel &s) -> bool {
+                return !(it.iter == s.end);
+            }
+
+            template <typename Iter, typename Index>
+            friend auto operator!=(const EnumerateSentinel &s,
+                                   const EnumerateIterator<Iter, Index> &it) -> bool {
+                return !(it.iter == s.end);
             }
         };
 
+        template <typename Iter>
+        auto enumerate_distance(const Iter &first, const Iter &last,
+                                std::random_access_iterator_tag) -> std::ptrdiff_t {
+            return static_cast<std::ptrdiff_t>(last - first);
+        }
+
+        template <typename Iter>
+        auto enumerate_distance(const Iter & /* first */, const Iter & /* last */,
+                                std::input_iterator_tag) -> std::ptrdiff_t {
+            return 0;
+        }
+
+        /**
+         * @brief enumerate_end(first, last, start)
+         *
+         * Returns the end of an enumeration: an `EnumerateIterator` when the
+         * underlying range is a common range (its index is `start` plus the size
+         * of the range over random-access iterators), and an `EnumerateSentinel`
+         * otherwise.
+         *
+         * @param[in] first
+         * @param[in] last
+         * @param[in] start
+         */
+        template <typename Iter, typename Index>
+        auto enumerate_end(const Iter &first, const Iter &last, Index start)
+            -> EnumerateIterator<Iter, Index> {
+            using category = typename std::iterator_traits<Iter>::iterator_category;
+            return EnumerateIterator<Iter, Index>{
+                static_cast<Index>(start + enumerate_distance(first, last, category{})), last};
+        }
+
+        template <typename Iter, typename Sent, typename Index>
+        auto enumerate_end(const Iter & /* first */, const Sent &last, Index /* start */)
+            -> EnumerateSentinel<Sent> {
+            return EnumerateSentinel<Sent>{last};
+        }
+
+        template <typename T> struct identity {
+            using type = T;
+        };
+
         /**
          * @brief EnumerateIterableWrapper
          *
@@ -84,77 +363,181 @@ namespace py {
          * wrapper for an iterable object. It provides two member functions, `begin()`
          * and `end()`, which return instances of the `EnumerateIterator` struct.
          *
+         * When `T` is an lvalue reference, the wrapper refers to the iterable (as a
+         * `std::reference_wrapper`, so that the wrapper stays assignable);
+         * otherwise it owns the iterable, which was moved into it. The first
+         * element has the index `start`.
+         *
          * @tparam T
+         * @tparam Index
          */
-        template <typename T> struct EnumerateIterableWrapper {
-            T &iterable;
+        template <typename T, typename Index = size_t> struct EnumerateIterableWrapper {
+            using container = typename std::remove_reference<T>::type;
+            using const_container = typename std::conditional<std::is_lvalue_reference<T>::value,
+                                                              container, const container>::type;
+            using storage = typename std::conditional<std::is_lvalue_reference<T>::value,
+                                                      std::reference_wrapper<container>, T>::type;
+
+            storage iterable;
+            Index start;
+
+            /**
+             * @brief base
+             *
+             * Returns the underlying iterable. A referred iterable stays mutable
+             * through a const wrapper; an owned one does not.
+             *
+             * @return container&
+             */
+            auto base() -> container & { return this->iterable; }
+
+            /**
+             * @brief base
+             *
+             * @return const_container&
+             */
+            auto base() const -> const_container & { return this->iterable; }
 
             /**
              * @brief begin
              *
              * The `begin()` function is a member function of the
              * `EnumerateIterableWrapper` struct. It returns an instance of the
-             * `EnumerateIterator<T>` struct, which is used to iterate over the elements
+             * `EnumerateIterator` struct, which is used to iterate over the elements
              * of the iterable object.
              *
-             * @return EnumerateIterator<T>
+             * @return EnumerateIterator
+             */
+            auto begin()
+                -> EnumerateIterator<decltype(std::begin(std::declval<container &>())), Index> {
+                return {this->start, std::begin(this->base())};
+            }
+
+            /**
+             * @brief begin
+             *
+             * @return EnumerateIterator
              */
-            auto begin() const -> EnumerateIterator<T> {
-                return EnumerateIterator<T>{0, std::begin(iterable)};
+            auto begin() const
+                -> EnumerateIterator<decltype(std::begin(std::declval<const_container &>())),
+                                     Index> {
+                return {this->start, std::begin(this->base())};
             }
 
             /**
              * @brief end
              *
              * The `end()` function is a member function of the
-             * `EnumerateIterableWrapper` struct. It returns an instance of the
-             * `EnumerateIterator<T>` struct, which is used to mark the end of the
-             * iteration over the elements of the iterable object.
+             * `EnumerateIterableWrapper` struct. It returns an `EnumerateIterator`,
+             * or an `EnumerateSentinel` if the end of the iterable object is a
+             * sentinel, which marks the end of the iteration.
              *
-             * @return EnumerateIterator<T>
+             * @return EnumerateIterator or EnumerateSentinel
              */
-            auto end() const -> EnumerateIterator<T> {
-                return EnumerateIterator<T>{0, std::end(iterable)};
+            auto end() -> decltype(enumerate_end(std::begin(std::declval<container &>()),
+                                                 std::end(std::declval<container &>()),
+                                                 std::declval<Index>())) {
+                return enumerate_end(std::begin(this->base()), std::end(this->base()), this->start);
+            }
+
+            /**
+             * @brief end
+             *
+             * @return EnumerateIterator or EnumerateSentinel
+             */
+            auto end() const
+                -> decltype(enumerate_end(std::begin(std::declval<const_container &>()),
+                                          std::end(std::declval<const_container &>()),
+                                          std::declval<Index>())) {
+                return enumerate_end(std::begin(this->base()), std::end(this->base()), this->start);
             }
         };
 
     }  // namespace detail
 
     /**
-     * @brief enumerate(T &iterable)
+     * @brief enumerate<Index>(T &&iterable, start)
      *
-     * The `enumerate(T &iterable)` function is a utility function that allows you
+     * The `enumerate(T &&iterable)` function is a utility function that allows you
      * to iterate over a container or range and also get the index of each element
      * in the iteration. It returns an instance of the
-     * `detail::EnumerateIterableWrapper<T>` class, which provides a range-based for
-     * loop compatible interface.
+     * `detail::EnumerateIterableWrapper<T, Index>` class, which provides a
+     * range-based for loop compatible interface.
+     *
+     * An lvalue is referred to; an rvalue, such as a temporary container or a
+     * view, is moved into the wrapper, so the wrapper can outlive the expression
+     * that produced it.
      *
+     * As in Python, the indices count from `start`. They have the type `Index`;
+     * a 32-bit index lets the compiler vectorize index arithmetic over 32-bit
+     * elements at full width, e.g. `enumerate<int32_t>(a)`.
+     *
+     * @tparam Index
      * @tparam T
      * @param[in] iterable
-     * @return detail::EnumerateIterableWrapper<T>
+     * @param[in] start
+     * @return detail::EnumerateIterableWrapper<T, Index>
      */
-    template <typename T> inline auto enumerate(T &iterable)
-        -> detail::EnumerateIterableWrapper<T> {
-        return detail::EnumerateIterableWrapper<T>{iterable};
+    template <typename Index = size_t, typename T>
+    inline auto enumerate(T &&iterable, typename detail::identity<Index>::type start = 0)
+        -> detail::EnumerateIterableWrapper<T, Index> {
+        return detail::EnumerateIterableWrapper<T, Index>{std::forward<T>(iterable), start};
     }
 
     /**
-     * @brief const_enumerate(const T &iterable)
+     * @brief const_enumerate<Index>(const T &iterable, start)
      *
      * The `const_enumerate(const T &iterable)` function is a utility function that
      * allows you to iterate over a constant container or range and also get the
      * index of each element in the iteration. It returns an instance of the
-     * `detail::EnumerateIterableWrapper<const T>` class, which provides a
+     * `detail::EnumerateIterableWrapper<const T &, Index>` class, which provides a
      * range-based for loop compatible interface. This function is useful when you
      * want to iterate over a constant container without modifying its elements.
      *
+     * @tparam Index
+     * @tparam T
+     * @param[in] iterable
+     * @param[in] start
+     * @return detail::EnumerateIterableWrapper<const T &, Index>
+     */
+    template <typename Index = size_t, typename T>
+    inline auto const_enumerate(const T &iterable,
+                                typename detail::identity<Index>::type start = 0)
+        -> detail::EnumerateIterableWrapper<const T &, Index> {
+        return detail::EnumerateIterableWrapper<const T &, Index>{iterable, start};
+    }
+
+    /**
+     * @brief const_enumerate<Index>(T &&iterable, start)
+     *
+     * Same as above for an rvalue, which is moved into the wrapper.
+     *
+     * @tparam Index
      * @tparam T
      * @param[in] iterable
-     * @return detail::EnumerateIterableWrapper<const T>
+     * @param[in] start
+     * @return detail::EnumerateIterableWrapper<const T, Index>
      */
-    template <typename T> inline auto const_enumerate(const T &iterable)
-        -> detail::EnumerateIterableWrapper<const T> {
-        return detail::EnumerateIterableWrapper<const T>{iterable};
+    template <typename Index = size_t, typename T,
+              typename = typename std::enable_if<!std::is_reference<T>::value>::type>
+    inline auto const_enumerate(T &&iterable, typename detail::identity<Index>::type start = 0)
+        -> detail::EnumerateIterableWrapper<const T, Index> {
+        return detail::EnumerateIterableWrapper<const T, Index>{std::move(iterable), start};
     }
 
 }  // namespace py
+
+#if defined(__cpp_lib_ranges)
+
+// An enumeration that refers to an lvalue is cheap to copy and its iterators do
+// not dangle when it is destroyed, so it is a borrowed view.
+namespace std::ranges {
+    template <typename T, typename Index>
+    inline constexpr bool enable_borrowed_range<py::detail::EnumerateIterableWrapper<T &, Index>>
+        = true;
+
+    template <typename T, typename Index>
+    inline constexpr bool enable_view<py::detail::EnumerateIterableWrapper<T &, Index>> = true;
+}  // namespace std::ranges
+
+#endif
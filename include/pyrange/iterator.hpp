@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>  // import std::ptrdiff_t
+
+#include "range.hpp"
+
+namespace py {
+
+    namespace detail {
+
+        /**
+         * @brief RandomAccessOps
+         *
+         * The arithmetic and comparison operators of a random-access iterator,
+         * written once for the views that are indexed by a position
+         * (`chunks()`, `distribute()`, `permuted()`, `prefetched()`). `Derived`
+         * supplies `operator*`, `advance(n)` and `distance_from(other)` (that
+         * is, `*this - other`). It may also define `increment()`, `decrement()`
+         * or `equal(other)` when it has a cheaper step or test than the
+         * defaults below, which go through the first two.
+         *
+         * @tparam Derived
+         * @tparam Reference the type of `*it`
+         * @tparam Difference
+         */
+        template <typename Derived, typename Reference, typename Difference = std::ptrdiff_t>
+        struct RandomAccessOps {
+            CONSTEXPR14 void increment() { this->self().advance(1); }
+
+            CONSTEXPR14 void decrement() { this->self().advance(-1); }
+
+            constexpr auto equal(const Derived &other) const -> bool {
+                return this->self().distance_from(other) == 0;
+            }
+
+            CONSTEXPR14 auto operator[](Difference n) const -> Reference {
+                return *(this->self() + n);
+            }
+
+            CONSTEXPR14 auto operator++() -> Derived & {
+                this->self().increment();
+                return this->self();
+            }
+
+            CONSTEXPR14 auto operator++(int) -> Derived {
+                auto temp = this->self();
+                this->self().increment();
+                return temp;
+            }
+
+            CONSTEXPR14 auto operator--() -> Derived & {
+                this->self().decrement();
+                return this->self();
+            }
+
+            CONSTEXPR14 auto operator--(int) -> Derived {
+                auto temp = this->self();
+                this->self().decrement();
+                return temp;
+            }
+
+            CONSTEXPR14 auto operator+=(Difference n) -> Derived & {
+                this->self().advance(n);
+                return this->self();
+            }
+
+            CONSTEXPR14 auto operator-=(Difference n) -> Derived & {
+                this->self().advance(-n);
+                return this->self();
+            }
+
+            CONSTEXPR14 auto operator+(Difference n) const -> Derived {
+                auto temp = this->self();
+                temp.advance(n);
+                return temp;
+            }
+
+            CONSTEXPR14 auto operator-(Difference n) const -> Derived {
+                auto temp = this->self();
+                temp.advance(-n);
+                return temp;
+            }
+
+            // hidden friends, so that C++20 finds no reversed candidates to
+            // compete with them
+
+            friend CONSTEXPR14 auto operator+(Difference n, const Derived &it) -> Derived {
+                return it + n;
+            }
+
+            friend constexpr auto operator-(const Derived &a, const Derived &b) -> Difference {
+                return a.distance_from(b);
+            }
+
+            friend constexpr auto operator==(const Derived &a, const Derived &b) -> bool {
+                return a.equal(b);
+            }
+            friend constexpr auto operator!=(const Derived &a, const Derived &b) -> bool {
+                return !a.equal(b);
+            }
+            friend constexpr auto operator<(const Derived &a, const Derived &b) -> bool {
+                return a.distance_from(b) < 0;
+            }
+            friend constexpr auto operator>(const Derived &a, const Derived &b) -> bool {
+                return a.distance_from(b) > 0;
+            }
+            friend constexpr auto operator<=(const Derived &a, const Derived &b) -> bool {
+                return a.distance_from(b) <= 0;
+            }
+            friend constexpr auto operator>=(const Derived &a, const Derived &b) -> bool {
+                return a.distance_from(b) >= 0;
+            }
+
+          private:
+            CONSTEXPR14 auto self() -> Derived & { return static_cast<Derived &>(*this); }
+
+            constexpr auto self() const -> const Derived & {
+                return static_cast<const Derived &>(*this);
+            }
+        };
+
+    }  // namespace detail
+
+}  // namespace py
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <cerrno>        // import errno
+#include <cstddef>       // import size_t
+#include <cstring>       // import std::memchr
+#include <iterator>      // import std::forward_iterator_tag
+#include <string>        // import std::string, std::string_view
+#include <system_error>  // import std::system_error
+#include <vector>        // import std::vector
+
+#if defined(_WIN32)
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>  // import CreateFileMappingA, MapViewOfFile
+#else
+#    include <fcntl.h>     // import open
+#    include <sys/mman.h>  // import mmap, munmap, madvise
+#    include <sys/stat.h>  // import fstat
+#    include <unistd.h>    // import close
+#endif
+
+#include "chunks.hpp"
+
+namespace py {
+
+    /**
+     * @brief string_view
+     *
+     * The record type of `mapped_lines()` and `mapped_records()`:
+     * `std::string_view` when the standard library has it, `Span<const char>`
+     * otherwise.
+     */
+#if defined(__cpp_lib_string_view)
+    using string_view = std::string_view;
+#else
+    using string_view = Span<const char>;
+#endif
+
+    /**
+     * @brief MappedFile
+     *
+     * A read-only memory mapping of a whole file. The pages are loaded by the
+     * operating system on first access, so opening a file of any size is cheap
+     * and nothing is copied. The mapping is released by the destructor; a
+     * `MappedFile` can be moved but not copied. An empty file has a null
+     * `data()`.
+     */
+    class MappedFile {
+        const char *ptr = nullptr;
+        size_t len = 0;
+
+      public:
+        MappedFile() = default;
+
+        /**
+         * @brief Construct a new Mapped File object
+         *
+         * @param[in] path
+         * @throw std::system_error if the file cannot be opened or mapped
+         */
+        explicit MappedFile(const std::string &path) {
+#if defined(_WIN32)
+            auto fail = [&path](DWORD error) {
+                throw std::system_error(static_cast<int>(error), std::system_category(), path);
+            };
+            auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                fail(GetLastError());
+            }
+            auto size = LARGE_INTEGER{};
+            if (!GetFileSizeEx(file, &size)) {
+                const auto error = GetLastError();
+                CloseHandle(file);
+                fail(error);
+            }
+            if (size.QuadPart > 0) {
+                auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                const auto error = GetLastError();
+                CloseHandle(file);
+                if (mapping == nullptr) {
+                    fail(error);
+                }
+                auto *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                const auto view_error = GetLastError();
+                CloseHandle(mapping);
+                if (view == nullptr) {
+                    fail(view_error);
+                }
+                this->ptr = static_cast<const char *>(view);
+                this->len = static_cast<size_t>(size.QuadPart);
+            } else {
+                CloseHandle(file);
+            }
+#else
+            auto fail = [&path](int error) {
+                throw std::system_error(error, std::generic_category(), path);
+            };
+            const auto fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                fail(errno);
+            }
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                const auto error = errno;
+                ::close(fd);
+                fail(error);
+            }
+            if (info.st_size > 0) {
+                const auto size = static_cast<size_t>(info.st_size);
+                auto *view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                const auto error = errno;
+                ::close(fd);  // the mapping keeps the file open
+                if (view == MAP_FAILED) {
+                    fail(error);
+                }
+                ::madvise(view, size, MADV_SEQUENTIAL);  // a hint, failure is harmless
+                this->ptr = static_cast<const char *>(view);
+                this->len = size;
+            } else {
+                ::close(fd);
+            }
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        auto operator=(const MappedFile &) -> MappedFile & = delete;
+
+        MappedFile(MappedFile &&other) noexcept : ptr(other.ptr), len(other.len) {
+            other.ptr = nullptr;
+            other.len = 0;
+        }
+
+        auto operator=(MappedFile &&other) noexcept -> MappedFile & {
+            if (this != &other) {
+                this->unmap();
+                this->ptr = other.ptr;
+                this->len = other.len;
+                other.ptr = nullptr;
+                other.len = 0;
+            }
+            return *this;
+        }
+
+        ~MappedFile() { this->unmap(); }
+
+        auto data() const -> const char * { return this->ptr; }
+        auto size() const -> size_t { return this->len; }
+        auto empty() const -> bool { return this->len == 0; }
+
+      private:
+        void unmap() {
+            if (this->ptr != nullptr) {
+#if defined(_WIN32)
+                UnmapViewOfFile(this->ptr);
+#else
+                ::munmap(const_cast<char *>(this->ptr), this->len);
+#endif
+            }
+        }
+    };
+
+    /**
+     * @brief LineIterator
+     *
+     * The forward iterator of a `LineView`. It holds the current line as the
+     * range `[pos, eol)`; the next newline is found with `std::memchr`, which
+     * the C library implements with SIMD compares.
+     */
+    struct LineIterator {
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = string_view;
+        using reference = string_view;
+        using pointer = void;
+
+        const char *pos = nullptr;
+        const char *last = nullptr;
+        const char *eol = nullptr;  // the newline ending the line at `pos`, or `last`
+
+        static auto find_eol(const char *first, const char *last) -> const char * {
+            const auto *found = static_cast<const char *>(
+                std::memchr(first, '\n', static_cast<size_t>(last - first)));
+            return found != nullptr ? found : last;
+        }
+
+        LineIterator() = default;
+
+        LineIterator(const char *first, const char *last)
+            : pos(first), last(last), eol(first == last ? last : find_eol(first, last)) {}
+
+        auto operator*() const -> reference {
+            return reference(this->pos, static_cast<size_t>(this->eol - this->pos));
+        }
+
+        auto operator++() -> LineIterator & {
+            this->pos = this->eol == this->last ? this->last : this->eol + 1;
+            if (this->pos != this->last) {
+                this->eol = find_eol(this->pos, this->last);
+            }
+            return *this;
+        }
+
+        auto operator++(int) -> LineIterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        auto operator==(const LineIterator &other) const -> bool {
+            return this->pos == other.pos;
+        }
+        auto operator!=(const LineIterator &other) const -> bool {
+            return this->pos != other.pos;
+        }
+    };
+
+    /**
+     * @brief LineView
+     *
+     * The lines of the text `[first, last)`, without their newlines. A final
+     * line without a newline is yielded too, and a `'\r'` before a newline is
+     * kept, as with `std::getline`. The view does not own the text.
+     */
+    struct LineView {
+        using iterator = LineIterator;
+        using value_type = string_view;
+
+        const char *first;
+        const char *last;
+
+        auto begin() const -> iterator { return iterator(this->first, this->last); }
+        auto end() const -> iterator { return iterator(this->last, this->last); }
+        auto empty() const -> bool { return this->first == this->last; }
+
+        /**
+         * @brief split
+         *
+         * Cuts the text into at most `parts` pieces of about the same number of
+         * bytes, each ending just after a newline (or at the end of the text),
+         * so that every line falls into exactly one piece. The pieces can be
+         * scanned in parallel, e.g. by `parallel_for` over their indices. Line
+         * numbers restart in each piece. Empty pieces are dropped.
+         *
+         * @param[in] parts
+         * @return std::vector<LineView>
+         */
+        auto split(size_t parts) const -> std::vector<LineView> {
+            auto pieces = std::vector<LineView>{};
+            const auto size = static_cast<size_t>(this->last - this->first);
+            const auto *begin = this->first;
+            for (size_t k = 1; k <= parts && begin != this->last; ++k) {
+                const auto *cut = this->first + size / parts * k + size % parts * k / parts;
+                if (cut < begin) {
+                    cut = begin;
+                }
+                if (k == parts || cut == this->last) {
+                    cut = this->last;
+                } else {
+                    cut = LineIterator::find_eol(cut, this->last);
+                    cut = cut == this->last ? cut : cut + 1;
+                }
+                if (cut != begin) {
+                    pieces.push_back(LineView{begin, cut});
+                }
+                begin = cut;
+            }
+            return pieces;
+        }
+    };
+
+    /**
+     * @brief MappedLines
+     *
+     * The lines of a memory-mapped file; see `mapped_lines()`.
+     */
+    struct MappedLines {
+        using iterator = LineIterator;
+        using value_type = string_view;
+
+        MappedFile file;
+
+        auto view() const -> LineView {
+            return LineView{this->file.data(), this->file.data() + this->file.size()};
+        }
+
+        auto begin() const -> iterator { return this->view().begin(); }
+        auto end() const -> iterator { return this->view().end(); }
+        auto empty() const -> bool { return this->file.empty(); }
+
+        /**
+         * @brief split
+         *
+         * Same as `LineView::split()`. The pieces refer to the mapping, which
+         * must outlive them.
+         *
+         * @param[in] parts
+         * @return std::vector<LineView>
+         */
+        auto split(size_t parts) const -> std::vector<LineView> {
+            return this->view().split(parts);
+        }
+    };
+
+    /**
+     * @brief MappedRecords
+     *
+     * The fixed-width records of a memory-mapped file; see `mapped_records()`.
+     */
+    struct MappedRecords {
+        using view_type = detail::SliceView<const char, string_view>;
+        using iterator = view_type::iterator;
+        using value_type = string_view;
+
+        MappedFile file;
+        size_t width;
+
+        auto view() const -> view_type {
+            const auto n = this->file.size();
+            const auto count = this->width == 0 ? 0 : (n + this->width - 1) / this->width;
+            return view_type{this->file.data(), n, this->width, this->width, count};
+        }
+
+        auto begin() const -> iterator { return this->view().begin(); }
+        auto end() const -> iterator { return this->view().end(); }
+        auto size() const -> size_t { return this->view().size(); }
+        auto empty() const -> bool { return this->view().empty(); }
+        auto operator[](size_t n) const -> string_view { return this->view()[n]; }
+    };
+
+    /**
+     * @brief mapped_lines(path)
+     *
+     * The `mapped_lines()` function maps the file at `path` into memory and
+     * yields its lines as `string_view`s into the mapping, without reading or
+     * copying the file up front. It replaces a `std::getline` loop, and
+     * `enumerate(mapped_lines(path))` numbers the lines. `split(parts)` cuts
+     * the file at line boundaries for parallel scanning. The views stay valid
+     * as long as the returned range lives.
+     *
+     * @param[in] path
+     * @return MappedLines
+     * @throw std::system_error if the file cannot be opened or mapped
+     */
+    inline auto mapped_lines(const std::string &path) -> MappedLines {
+        return MappedLines{MappedFile(path)};
+    }
+
+    /**
+     * @brief mapped_records(path, width)
+     *
+     * The `mapped_records()` function maps the file at `path` into memory and
+     * yields consecutive records of `width` bytes as `string_view`s, the last
+     * one shorter if `width` does not divide the file size. The range is random
+     * access, so it can be passed to `parallel_for` directly. A zero `width`
+     * yields no records.
+     *
+     * @param[in] path
+     * @param[in] width
+     * @return MappedRecords
+     * @throw std::system_error if the file cannot be opened or mapped
+     */
+    inline auto mapped_records(const std::string &path, size_t width) -> MappedRecords {
+        return MappedRecords{MappedFile(path), width};
+    }
+
+}  // namespace py
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <array>    // import std::array
+#include <cassert>  // import assert
+#include <cstddef>  // import size_t
+#include <iterator>
+
+#include "range.hpp"
+
+namespace py {
+
+    template <typename T, size_t N> struct NdRange;
+
+    /**
+     * @brief NdRangeIterator
+     *
+     * The `NdRangeIterator` struct walks the Cartesian product of the dimensions
+     * of an `NdRange` and yields the current index tuple as a `std::array<T, N>`.
+     * Without tiling the last dimension varies fastest (row-major order). With a
+     * tile shape, the iterator visits all indices of one tile in row-major order
+     * before it moves to the next tile, and the tiles themselves are visited in
+     * row-major order.
+     *
+     * @tparam T
+     * @tparam N
+     */
+    template <typename T, size_t N> struct NdRangeIterator {
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::array<T, N>;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        NdRange<T, N> rng;
+        value_type idx;     // current index tuple
+        value_type origin;  // first index of the current tile
+        value_type bound;   // one past the last index of the current tile
+        size_t pos;         // number of tuples visited before this one
+
+        /**
+         * @brief Not equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator!=(const NdRangeIterator &other) const -> bool {
+            return this->pos != other.pos;
+        }
+
+        /**
+         * @brief Equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator==(const NdRangeIterator &other) const -> bool {
+            return this->pos == other.pos;
+        }
+
+        /**
+         * @brief
+         *
+         * Returns the current index tuple.
+         *
+         * @return reference
+         */
+        constexpr auto operator*() const -> reference { return this->idx; }
+
+        /**
+         * @brief linear
+         *
+         * Returns the row-major (collapsed) linear index of the current tuple,
+         * i.e. its offset in a dense array with the shape of the range. Without
+         * tiling this is simply the number of tuples visited so far.
+         *
+         * @return size_t
+         */
+        CONSTEXPR14 auto linear() const -> size_t { return this->rng.linear(this->idx); }
+
+        /**
+         * @brief
+         *
+         * The pre-increment operator advances to the next index tuple. The
+         * innermost dimension of the current tile is incremented first; when it
+         * reaches the end of the tile it is reset and the increment carries over
+         * to the next outer dimension. When the whole tile has been visited the
+         * same carry is applied to the tile origin.
+         *
+         * @return NdRangeIterator&
+         */
+        CONSTEXPR14 auto operator++() -> NdRangeIterator & {
+            ++this->pos;
+            for (size_t d = N; d-- != 0;) {
+                ++this->idx[d];
+                if (this->idx[d] != this->bound[d]) {
+                    return *this;
+                }
+                this->idx[d] = this->origin[d];
+            }
+            for (size_t d = N; d-- != 0;) {
+                this->origin[d] = this->bound[d];
+                if (this->origin[d] != this->rng.dims[d].stop) {
+                    this->bound[d] = this->rng.tile_stop(d, this->origin[d]);
+                    break;
+                }
+                this->origin[d] = this->rng.dims[d].start;
+                this->bound[d] = this->rng.tile_stop(d, this->origin[d]);
+            }
+            this->idx = this->origin;
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * @return NdRangeIterator
+         */
+        CONSTEXPR14 auto operator++(int) -> NdRangeIterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+    };
+
+    /**
+     * @brief NdRange
+     *
+     * The `NdRange` struct represents the Cartesian product of `N` ranges
+     * `Range<T>`, optionally traversed tile by tile. Each dimension is an
+     * ordinary `Range<T>`, so it keeps its constexpr `size()` and `contains()`.
+     *
+     * Walking a large grid in row-major order touches a whole row before it comes
+     * back to the neighbouring row, which evicts the data of the previous rows
+     * from cache for kernels such as transposes and stencils. Setting a tile
+     * shape (e.g. 64 x 64) makes the iterator finish each block before it moves
+     * on, so the working set stays in L1/L2.
+     *
+     * @tparam T
+     * @tparam N
+     */
+    template <typename T, size_t N> struct NdRange {
+        using iterator = NdRangeIterator<T, N>;
+        using value_type = std::array<T, N>;
+
+        std::array<Range<T>, N> dims;
+        std::array<size_t, N> tile;  // 0 means the whole extent of the dimension
+
+        /**
+         * @brief begin
+         *
+         * @return iterator
+         */
+        CONSTEXPR14 auto begin() const -> iterator { return this->make_iterator(0); }
+
+        /**
+         * @brief end
+         *
+         * @return iterator
+         */
+        CONSTEXPR14 auto end() const -> iterator { return this->make_iterator(this->size()); }
+
+        /**
+         * @brief empty
+         *
+         * @return true
+         * @return false
+         */
+        CONSTEXPR14 auto empty() const -> bool {
+            for (const auto &dim : this->dims) {
+                if (dim.empty()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief size
+         *
+         * Returns the number of index tuples, i.e. the product of the sizes of all
+         * dimensions.
+         *
+         * @return size_t
+         */
+        CONSTEXPR14 auto size() const -> size_t {
+            auto n = size_t(1);
+            for (const auto &dim : this->dims) {
+                n *= dim.size();
+            }
+            return n;
+        }
+
+        /**
+         * @brief shape
+         *
+         * @return std::array<size_t, N>
+         */
+        CONSTEXPR14 auto shape() const -> std::array<size_t, N> {
+            auto result = std::array<size_t, N>{};
+            for (size_t d = 0; d != N; ++d) {
+                result[d] = this->dims[d].size();
+            }
+            return result;
+        }
+
+        /**
+         * @brief contains
+         *
+         * @param[in] idx
+         * @return true
+         * @return false
+         */
+        CONSTEXPR14 auto contains(const value_type &idx) const -> bool {
+            for (size_t d = 0; d != N; ++d) {
+                if (!this->dims[d].contains(idx[d])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief linear
+         *
+         * Collapses an index tuple into its row-major linear index.
+         *
+         * @param[in] idx
+         * @return size_t
+         */
+        CONSTEXPR14 auto linear(const value_type &idx) const -> size_t {
+            auto k = size_t(0);
+            for (size_t d = 0; d != N; ++d) {
+                k = k * this->dims[d].size()
+                    + static_cast<size_t>(detail::range_distance(this->dims[d].start, idx[d]));
+            }
+            return k;
+        }
+
+        /**
+         * @brief
+         *
+         * Returns the index tuple with the row-major linear index `k` (the inverse
+         * of `linear()`). Requires `k < size()`, hence a non-empty range: an
+         * extent of 0 would make `k % n` divide by zero.
+         *
+         * @param[in] k
+         * @return value_type
+         */
+        CONSTEXPR14 auto operator[](size_t k) const -> value_type {
+            assert(k < this->size());
+            auto idx = value_type{};
+            for (size_t d = N; d-- != 0;) {
+                const auto n = this->dims[d].size();
+                idx[d] = this->dims[d][k % n];
+                k /= n;
+            }
+            return idx;
+        }  // no bounds checking
+
+        /**
+         * @brief tiled
+         *
+         * Returns a copy of this range that is traversed tile by tile. A tile
+         * extent of 0 stands for the whole extent of that dimension.
+         *
+         * @param[in] tile_shape
+         * @return NdRange
+         */
+        CONSTEXPR14 auto tiled(const std::array<size_t, N> &tile_shape) const -> NdRange {
+            return NdRange{this->dims, tile_shape};
+        }
+
+        /**
+         * @brief tile_stop
+         *
+         * Returns the end of the tile that starts at `origin` along dimension `d`.
+         *
+         * @param[in] d
+         * @param[in] origin
+         * @return T
+         */
+        CONSTEXPR14 auto tile_stop(size_t d, T origin) const -> T {
+            const auto &dim = this->dims[d];
+            const auto left = static_cast<size_t>(detail::range_distance(origin, dim.stop));
+            if (this->tile[d] == 0 || this->tile[d] >= left) {
+                return dim.stop;
+            }
+            return RangeIterator<T>{origin}[static_cast<std::ptrdiff_t>(this->tile[d])];
+        }
+
+      private:
+        CONSTEXPR14 auto make_iterator(size_t pos) const -> iterator {
+            auto first = value_type{};
+            auto bound = value_type{};
+            for (size_t d = 0; d != N; ++d) {
+                first[d] = this->dims[d].start;
+                bound[d] = this->tile_stop(d, first[d]);
+            }
+            return iterator{*this, first, first, bound, pos};
+        }
+    };
+
+    /**
+     * @brief product(Range<T> first, Range<T>... rest)
+     *
+     * The `product()` function returns the Cartesian product of the given ranges,
+     * like Python's `itertools.product`. The last range varies fastest.
+     *
+     * @tparam T
+     * @tparam Rngs
+     * @param[in] first
+     * @param[in] rest
+     * @return NdRange<T, 1 + sizeof...(Rngs)>
+     */
+    template <typename T, typename... Rngs>
+    CONSTEXPR14 auto product(const Range<T> &first, const Rngs &...rest)
+        -> NdRange<T, 1 + sizeof...(Rngs)> {
+        return NdRange<T, 1 + sizeof...(Rngs)>{{{first, rest...}}, {}};
+    }
+
+    /**
+     * @brief ndrange(const T (&shape)[N])
+     *
+     * The `ndrange({n0, n1, ...})` function returns the index space of an array
+     * with the given shape, i.e. the product of `range(n0)`, `range(n1)`, ...
+     *
+     * @tparam T
+     * @tparam N
+     * @param[in] shape
+     * @return NdRange<T, N>
+     */
+    template <typename T, size_t N> CONSTEXPR14 auto ndrange(const T (&shape)[N]) -> NdRange<T, N> {
+        auto result = NdRange<T, N>{};
+        for (size_t d = 0; d != N; ++d) {
+            result.dims[d] = range(shape[d]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief ndrange(const T (&shape)[N], const size_t (&tile)[N])
+     *
+     * Same as `ndrange(shape)`, traversed tile by tile.
+     *
+     * @tparam T
+     * @tparam N
+     * @param[in] shape
+     * @param[in] tile
+     * @return NdRange<T, N>
+     */
+    template <typename T, size_t N>
+    CONSTEXPR14 auto ndrange(const T (&shape)[N], const size_t (&tile)[N]) -> NdRange<T, N> {
+        auto result = ndrange(shape);
+        for (size_t d = 0; d != N; ++d) {
+            result.tile[d] = tile[d];
+        }
+        return result;
+    }
+
+}  // namespace py
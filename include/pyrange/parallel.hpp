@@ -0,0 +1,421 @@
+#pragma once
+
+#include <algorithm>           // import std::max
+#include <atomic>              // import std::atomic
+#include <condition_variable>  // import std::condition_variable
+#include <cstddef>             // import size_t
+#include <deque>               // import std::deque
+#include <exception>           // import std::exception_ptr
+#include <functional>          // import std::function
+#include <iterator>            // import std::begin() std::end()
+#include <mutex>               // import std::mutex
+#include <thread>              // import std::thread
+#include <utility>             // import std::pair
+#include <vector>              // import std::vector
+
+#include "enumerate.hpp"
+
+namespace py {
+
+    /**
+     * @brief ThreadPool
+     *
+     * The `ThreadPool` class is a small work-stealing thread pool. Every worker
+     * owns a double-ended task queue: it pushes and pops new tasks at the back
+     * (last in, first out, which keeps recently split subranges hot in its cache)
+     * while idle workers steal from the front of other queues, where the largest
+     * pending subranges are. Threads that do not belong to the pool share one
+     * extra queue.
+     *
+     * A thread that waits for its tasks to complete keeps running tasks from the
+     * pool, so nested `parallel_for` calls cannot deadlock, and a pool with zero
+     * workers simply runs everything on the calling thread.
+     */
+    class ThreadPool {
+      public:
+        using Task = std::function<void()>;
+
+        /**
+         * @brief Construct a new ThreadPool object
+         *
+         * @param[in] num_workers number of threads to spawn, in addition to the
+         *                        thread that calls `wait()`
+         */
+        explicit ThreadPool(size_t num_workers) : queues(num_workers + 1) {
+            this->workers.reserve(num_workers);
+            for (size_t id = 0; id != num_workers; ++id) {
+                this->workers.emplace_back([this, id] { this->work(id); });
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+        /**
+         * @brief Destroy the ThreadPool object
+         *
+         * The workers finish all pending tasks before they are joined.
+         */
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(this->sleep_mutex);
+                this->stopping = true;
+            }
+            this->wakeup.notify_all();
+            for (auto &worker : this->workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * @brief global
+         *
+         * Returns the process-wide pool that is used when no pool is given
+         * explicitly. It has one worker less than the hardware concurrency, because
+         * the calling thread takes part in the work.
+         *
+         * @return ThreadPool&
+         */
+        static auto global() -> ThreadPool & {
+            static ThreadPool pool(std::max(1U, std::thread::hardware_concurrency()) - 1U);
+            return pool;
+        }
+
+        /**
+         * @brief num_threads
+         *
+         * Returns the number of threads that execute tasks, including the thread
+         * that waits for them.
+         *
+         * @return size_t
+         */
+        auto num_threads() const -> size_t { return this->workers.size() + 1; }
+
+        /**
+         * @brief push
+         *
+         * Pushes a task onto the queue of the calling thread.
+         *
+         * @param[in] task
+         */
+        void push(Task task) {
+            auto &queue = this->queues[this->own_queue()];
+            // counted before it is published: a thief that pops the task at once
+            // must not decrement `pending` below zero
+            {
+                std::lock_guard<std::mutex> lock(this->sleep_mutex);
+                this->pending.fetch_add(1, std::memory_order_relaxed);
+            }
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(std::move(task));
+            }
+            this->wakeup.notify_one();
+        }
+
+        /**
+         * @brief wait
+         *
+         * Runs tasks of the pool until `counter` drops to zero. While there is no
+         * task to run, the thread sleeps on the same condition variable as the
+         * workers, so it does not burn a core during long tasks. `counter` must be
+         * decremented through `release()`, which wakes it up.
+         *
+         * @param[in] counter
+         */
+        void wait(const std::atomic<size_t> &counter) {
+            const auto self = this->own_queue();
+            while (counter.load(std::memory_order_acquire) != 0) {
+                if (this->try_run(self)) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(this->sleep_mutex);
+                this->wakeup.wait(lock, [this, &counter] {
+                    return counter.load(std::memory_order_acquire) == 0
+                           || this->pending.load(std::memory_order_relaxed) != 0;
+                });
+            }
+        }
+
+        /**
+         * @brief release
+         *
+         * Decrements `counter`. The thread that drops it to zero wakes the threads
+         * that `wait()` for it; `counter` is not touched after that, so the waiter
+         * may destroy it as soon as it returns.
+         *
+         * @param[in,out] counter
+         */
+        void release(std::atomic<size_t> &counter) {
+            if (counter.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(this->sleep_mutex);
+                this->wakeup.notify_all();
+            }
+        }
+
+      private:
+        struct alignas(64) Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<Queue> queues;
+        std::vector<std::thread> workers;
+        std::mutex sleep_mutex;
+        std::condition_variable wakeup;
+        std::atomic<size_t> pending{0};
+        bool stopping = false;
+
+        static auto current() -> std::pair<const ThreadPool *, size_t> & {
+            static thread_local std::pair<const ThreadPool *, size_t> cur{nullptr, 0};
+            return cur;
+        }
+
+        auto own_queue() const -> size_t {
+            const auto &cur = current();
+            return cur.first == this ? cur.second : this->workers.size();
+        }
+
+        auto try_run(size_t self) -> bool {
+            auto task = Task{};
+            {
+                auto &queue = this->queues[self];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.tasks.empty()) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+            }
+            for (size_t k = 1; !task && k != this->queues.size(); ++k) {
+                auto &victim = this->queues[(self + k) % this->queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                }
+            }
+            if (!task) {
+                return false;
+            }
+            this->pending.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            return true;
+        }
+
+        void work(size_t id) {
+            current() = std::make_pair(this, id);
+            while (true) {
+                if (this->try_run(id)) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(this->sleep_mutex);
+                this->wakeup.wait(lock, [this] {
+                    return this->stopping || this->pending.load(std::memory_order_relaxed) != 0;
+                });
+                if (this->stopping && this->pending.load(std::memory_order_relaxed) == 0) {
+                    return;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Partition
+     *
+     * `Partition::Adaptive` halves the range until the pieces are no larger than
+     * the grain size; when no grain size is given it is derived from the number
+     * of threads. `Partition::Deterministic` always hands out the blocks
+     * `[k * grain, (k + 1) * grain)` of the range, independent of the number of
+     * threads, which makes per-chunk results reproducible from run to run and
+     * from machine to machine.
+     */
+    enum class Partition { Adaptive, Deterministic };
+
+    namespace detail {
+
+        constexpr size_t deterministic_grain = 1024;
+
+        /**
+         * @brief SubRange
+         *
+         * The `SubRange` struct is a pair of iterators that describes the part of a
+         * range that is handed to the body of `parallel_for_chunk`.
+         *
+         * @tparam Iter
+         */
+        template <typename Iter> struct SubRange {
+            Iter first;
+            Iter last;
+
+            auto begin() const -> Iter { return this->first; }
+            auto end() const -> Iter { return this->last; }
+        };
+
+        template <typename Iter> auto split_distance(const Iter &first, const Iter &last)
+            -> std::ptrdiff_t {
+            return last - first;
+        }
+
+        template <typename Iter> auto split_advance(const Iter &it, std::ptrdiff_t n) -> Iter {
+            return it + n;
+        }
+
+        /**
+         * @brief ForkJoin
+         *
+         * The `ForkJoin` struct recursively splits a range: each call keeps the left
+         * half and pushes the right half onto the pool, until the piece is no larger
+         * than the grain size and the body is run on it. It counts the pieces that
+         * are still running so that the caller can wait for all of them, and keeps
+         * the first exception that a body throws.
+         *
+         * @tparam Iter
+         * @tparam Body
+         */
+        template <typename Iter, typename Body> struct ForkJoin {
+            ThreadPool &pool;
+            const Body &body;
+            std::ptrdiff_t grain;
+            Partition partition;
+            std::atomic<size_t> running{1};
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;
+
+            ForkJoin(ThreadPool &pool, const Body &body, std::ptrdiff_t grain,
+                     Partition partition)
+                : pool(pool), body(body), grain(grain), partition(partition) {}
+
+            void run(Iter first, Iter last) {
+                try {
+                    auto n = split_distance(first, last);
+                    while (n > this->grain) {
+                        auto half = n / 2;
+                        if (this->partition == Partition::Deterministic) {
+                            const auto blocks = (n + this->grain - 1) / this->grain;
+                            half = blocks / 2 * this->grain;
+                        }
+                        const auto mid = split_advance(first, half);
+                        this->running.fetch_add(1, std::memory_order_relaxed);
+                        this->pool.push([this, mid, last] { this->run(mid, last); });
+                        last = mid;
+                        n = half;
+                    }
+                    if (!this->failed.load(std::memory_order_relaxed)) {
+                        this->body(SubRange<Iter>{first, last});
+                    }
+                } catch (...) {
+                    if (!this->failed.exchange(true)) {
+                        this->error = std::current_exception();
+                    }
+                }
+                this->pool.release(this->running);
+            }
+        };
+
+    }  // namespace detail
+
+    /**
+     * @brief parallel_for_chunk(pool, rng, body, grain, partition)
+     *
+     * The `parallel_for_chunk` function splits `rng` into subranges and calls
+     * `body` once for every subrange, on the threads of `pool`. `rng` may be a
+     * `Range`, a `StepRange`, an `EnumerateIterableWrapper` over a random-access
+     * container, or any other range with random-access iterators. The subrange
+     * passed to `body` has `begin()` and `end()` and can be used in a range-based
+     * for loop. The function returns after all subranges have been processed; if
+     * a body throws, the first exception is rethrown.
+     *
+     * @tparam Rng
+     * @tparam Body
+     * @param[in] pool
+     * @param[in] rng
+     * @param[in] body
+     * @param[in] grain largest subrange that is not split further (0: automatic)
+     * @param[in] partition
+     */
+    template <typename Rng, typename Body>
+    void parallel_for_chunk(ThreadPool &pool, const Rng &rng, const Body &body, size_t grain = 0,
+                            Partition partition = Partition::Adaptive) {
+        using Iter = decltype(std::begin(rng));
+        const auto first = std::begin(rng);
+        const auto last = std::end(rng);
+        if (grain == 0) {
+            const auto n = static_cast<size_t>(detail::split_distance(first, last));
+            grain = partition == Partition::Deterministic ? detail::deterministic_grain
+                                                          : n / (8 * pool.num_threads()) + 1;
+        }
+        detail::ForkJoin<Iter, Body> fork_join(pool, body, static_cast<std::ptrdiff_t>(grain),
+                                               partition);
+        fork_join.run(first, last);
+        pool.wait(fork_join.running);
+        if (fork_join.error) {
+            std::rethrow_exception(fork_join.error);
+        }
+    }
+
+    /**
+     * @brief parallel_for_chunk(rng, body, grain, partition)
+     *
+     * Same as above, on `ThreadPool::global()`.
+     *
+     * @tparam Rng
+     * @tparam Body
+     * @param[in] rng
+     * @param[in] body
+     * @param[in] grain
+     * @param[in] partition
+     */
+    template <typename Rng, typename Body>
+    void parallel_for_chunk(const Rng &rng, const Body &body, size_t grain = 0,
+                            Partition partition = Partition::Adaptive) {
+        parallel_for_chunk(ThreadPool::global(), rng, body, grain, partition);
+    }
+
+    /**
+     * @brief parallel_for(pool, rng, body, grain, partition)
+     *
+     * The `parallel_for` function calls `body` for every element of `rng`, on the
+     * threads of `pool`. It is the parallel counterpart of
+     * `for (auto &&x : rng) body(x);`: within each subrange the elements are
+     * visited by a plain loop, which the compiler can still vectorize.
+     *
+     * @tparam Rng
+     * @tparam Body
+     * @param[in] pool
+     * @param[in] rng
+     * @param[in] body
+     * @param[in] grain largest subrange that is not split further (0: automatic)
+     * @param[in] partition
+     */
+    template <typename Rng, typename Body>
+    void parallel_for(ThreadPool &pool, const Rng &rng, const Body &body, size_t grain = 0,
+                      Partition partition = Partition::Adaptive) {
+        parallel_for_chunk(
+            pool, rng,
+            [&body](const auto &sub) {
+                for (auto &&x : sub) {
+                    body(x);
+                }
+            },
+            grain, partition);
+    }
+
+    /**
+     * @brief parallel_for(rng, body, grain, partition)
+     *
+     * Same as above, on `ThreadPool::global()`.
+     *
+     * @tparam Rng
+     * @tparam Body
+     * @param[in] rng
+     * @param[in] body
+     * @param[in] grain
+     * @param[in] partition
+     */
+    template <typename Rng, typename Body>
+    void parallel_for(const Rng &rng, const Body &body, size_t grain = 0,
+                      Partition partition = Partition::Adaptive) {
+        parallel_for(ThreadPool::global(), rng, body, grain, partition);
+    }
+
+}  // namespace py
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>   // import size_t
+#include <cstdint>   // import uint64_t
+#include <iterator>  // import std::random_access_iterator_tag
+
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // import std::ranges::enable_borrowed_range
+#endif
+
+#include "iterator.hpp"
+#include "range.hpp"
+
+namespace py {
+
+    namespace detail {
+
+        // splitmix64: steps `state` and returns the next well-mixed value
+        CONSTEXPR14 auto splitmix64(uint64_t &state) -> uint64_t {
+            auto z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31U);
+        }
+
+        /**
+         * @brief Feistel
+         *
+         * A keyed bijection of `[0, n)`. A balanced Feistel network permutes the
+         * `2 * half_bits`-bit integers, where `4^half_bits` is the smallest power
+         * of four not below `n`; an image that falls outside `[0, n)` is fed
+         * through the network again ("cycle walking") until it lands inside.
+         * Since the domain is less than `4 * n`, this takes fewer than four
+         * passes on average. The state is a handful of words and every
+         * image is computed independently, so any position can be looked up in
+         * constant expected time.
+         */
+        struct Feistel {
+            static constexpr size_t rounds = 4;
+
+            uint64_t n = 0;
+            unsigned half_bits = 1;
+            uint64_t mask = 1;
+            uint64_t keys[rounds] = {};
+
+            constexpr Feistel() = default;
+
+            CONSTEXPR14 Feistel(uint64_t n, uint64_t seed) : n(n) {
+                while (this->half_bits < 32 && (n - 1) >> (2 * this->half_bits) != 0) {
+                    ++this->half_bits;
+                }
+                this->mask = (uint64_t(1) << this->half_bits) - 1;
+                for (auto &key : this->keys) {
+                    key = splitmix64(seed);
+                }
+            }
+
+            // one pass through the network over the 2 * half_bits-bit domain
+            CONSTEXPR14 auto encrypt(uint64_t x) const -> uint64_t {
+                auto left = x >> this->half_bits;
+                auto right = x & this->mask;
+                for (auto key : this->keys) {
+                    // multiplicative hashing: the top bits depend on every input bit
+                    const auto z = (right ^ key) * 0x9E3779B97F4A7C15ULL;
+                    const auto next = left ^ (z >> (64 - this->half_bits));
+                    left = right;
+                    right = next;
+                }
+                return (left << this->half_bits) | right;
+            }
+
+            CONSTEXPR14 auto operator()(uint64_t x) const -> uint64_t {
+                do {
+                    x = this->encrypt(x);
+                } while (x >= this->n);
+                return x;
+            }  // requires x < n
+        };
+
+    }  // namespace detail
+
+    /**
+     * @brief PermutedIterator
+     *
+     * The random-access iterator of a `PermutedRange`. It counts positions
+     * `pos` and maps each one through the permutation when dereferenced.
+     *
+     * @tparam Rng
+     */
+    template <typename Rng>
+    struct PermutedIterator
+        : detail::RandomAccessOps<PermutedIterator<Rng>, typename Rng::value_type> {
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename Rng::value_type;
+        using pointer = void;
+        using reference = value_type;
+
+        Rng rng{};
+        detail::Feistel perm;
+        size_t pos = 0;
+
+        constexpr PermutedIterator() = default;
+        constexpr PermutedIterator(const Rng &rng, const detail::Feistel &perm, size_t pos)
+            : rng(rng), perm(perm), pos(pos) {}
+
+        CONSTEXPR14 auto operator*() const -> reference {
+            return this->rng[static_cast<size_t>(this->perm(this->pos))];
+        }
+
+        CONSTEXPR14 void advance(difference_type n) {
+            this->pos = static_cast<size_t>(static_cast<difference_type>(this->pos) + n);
+        }
+
+        constexpr auto distance_from(const PermutedIterator &other) const -> difference_type {
+            return static_cast<difference_type>(this->pos)
+                   - static_cast<difference_type>(other.pos);
+        }
+    };
+
+    /**
+     * @brief PermutedRange
+     *
+     * The values of a `Range` or `StepRange` in a pseudo-random order fixed by
+     * a seed. Nothing is materialized: the view holds the range and the keys of
+     * the permutation.
+     *
+     * @tparam Rng `Range<T>` or `StepRange<T>`
+     */
+    template <typename Rng> struct PermutedRange {
+        using iterator = PermutedIterator<Rng>;
+        using value_type = typename Rng::value_type;
+
+        Rng rng;
+        detail::Feistel perm;
+
+        constexpr auto begin() const -> iterator { return iterator{this->rng, this->perm, 0}; }
+
+        constexpr auto end() const -> iterator {
+            return iterator{this->rng, this->perm, this->rng.size()};
+        }
+
+        constexpr auto size() const -> size_t { return this->rng.size(); }
+
+        constexpr auto empty() const -> bool { return this->rng.size() == 0; }
+
+        /**
+         * @brief
+         *
+         * Returns the `k`-th value visited, in constant expected time.
+         *
+         * @param[in] k
+         * @return value_type
+         */
+        CONSTEXPR14 auto operator[](size_t k) const -> value_type {
+            return this->rng[static_cast<size_t>(this->perm(k))];
+        }  // no bounds checking
+
+        /**
+         * @brief
+         *
+         * @param[in] x
+         * @return true
+         * @return false
+         */
+        constexpr auto contains(value_type x) const -> bool { return this->rng.contains(x); }
+    };
+
+    /**
+     * @brief permuted(rng, seed)
+     *
+     * The `permuted()` function visits every value of `rng` exactly once, in a
+     * pseudo-random order determined by `seed`: a shuffled sweep without
+     * copying the range into a vector and calling `std::shuffle`. It needs no
+     * allocation, the same seed always gives the same order, and the view is
+     * random access, so it can be split across threads by `parallel_for`. The
+     * order is good enough for randomized sweeps and sampling, not for
+     * cryptography.
+     *
+     * @tparam T
+     * @param[in] rng
+     * @param[in] seed
+     * @return PermutedRange<Range<T>>
+     */
+    template <typename T>
+    CONSTEXPR14 auto permuted(const Range<T> &rng, uint64_t seed) -> PermutedRange<Range<T>> {
+        return PermutedRange<Range<T>>{rng, detail::Feistel(rng.size(), seed)};
+    }
+
+    /**
+     * @brief permuted(rng, seed)
+     *
+     * Same as above, for a `StepRange`.
+     *
+     * @tparam T
+     * @param[in] rng
+     * @param[in] seed
+     * @return PermutedRange<StepRange<T>>
+     */
+    template <typename T> CONSTEXPR14 auto permuted(const StepRange<T> &rng, uint64_t seed)
+        -> PermutedRange<StepRange<T>> {
+        return PermutedRange<StepRange<T>>{rng, detail::Feistel(rng.size(), seed)};
+    }
+
+}  // namespace py
+
+#if defined(__cpp_lib_ranges)
+
+// A permuted range holds its range and keys by value, so it is a borrowed view.
+namespace std::ranges {
+    template <typename Rng>
+    inline constexpr bool enable_borrowed_range<py::PermutedRange<Rng>> = true;
+
+    template <typename Rng> inline constexpr bool enable_view<py::PermutedRange<Rng>> = true;
+}  // namespace std::ranges
+
+#endif
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <cstddef>      // import size_t
+#include <functional>   // import std::reference_wrapper
+#include <type_traits>  // import std::decay
+#include <utility>      // import std::forward, std::move
+
+namespace py {
+
+    // Push-based pipelines, after transrangers: a stage is a callable that
+    // pushes its elements into a sink, and the sink returns `false` to stop.
+    // Every stage wraps the sink of the next one in a lambda, so that a whole
+    // pipeline inlines into the single loop of its source. There is no `empty()`
+    // / `front()` / `next()` protocol per element, which is what makes pull-based
+    // `filter` adaptors slow.
+
+    namespace detail {
+
+        /**
+         * @brief is_ranger<T>
+         *
+         * Whether `T` is a pipeline stage. A stage `r` is called as `r(sink)`; it
+         * calls `sink(x)` for each of its elements `x` until the sink returns
+         * `false`, and returns `true` when it ran to the end, `false` when the
+         * sink stopped it. A stage can be run only once if its source is a single
+         * pass range. Stages are marked by a nested `ranger_tag` type.
+         *
+         * A stage is run through a `const` call operator, so that a stage can refer
+         * to another one by a `const` reference. The callables and the owned
+         * iterables are `mutable` members: running a stage may mutate them, as it
+         * did when the stage was run by copy.
+         */
+        template <typename T, typename = void> struct is_ranger_impl : std::false_type {};
+
+        template <typename T>
+        struct is_ranger_impl<T,
+                              typename std::conditional<true, void, typename T::ranger_tag>::type>
+            : std::true_type {};
+
+        template <typename T> using is_ranger = is_ranger_impl<typename std::decay<T>::type>;
+
+        template <typename T>
+        using source_storage_t = typename std::conditional<
+            std::is_lvalue_reference<T>::value,
+            std::reference_wrapper<typename std::remove_reference<T>::type>, T>::type;
+
+        /**
+         * @brief SourceRanger
+         *
+         * The source stage over an iterable (a container, `py::range()`,
+         * `py::enumerate()`, ...). Like `EnumerateIterableWrapper`, it refers to
+         * lvalues and owns rvalues.
+         *
+         * @tparam T
+         */
+        template <typename T> struct SourceRanger {
+            using ranger_tag = void;
+
+            mutable source_storage_t<T> iterable;
+
+            template <typename Sink> auto operator()(Sink &sink) const -> bool {
+                typename std::remove_reference<T>::type &base = this->iterable;
+                for (auto &&x : base) {
+                    if (!sink(x)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+
+        /**
+         * @brief MapRanger
+         *
+         * Pushes `f(x)` for each element `x` of `rng`.
+         *
+         * @tparam F
+         * @tparam R
+         */
+        template <typename F, typename R> struct MapRanger {
+            using ranger_tag = void;
+
+            mutable F f;
+            R rng;
+
+            template <typename Sink> auto operator()(Sink &sink) const -> bool {
+                auto &fn = this->f;
+                auto stage = [&fn, &sink](auto &&x) -> bool {
+                    return sink(fn(std::forward<decltype(x)>(x)));
+                };
+                return this->rng(stage);
+            }
+        };
+
+        /**
+         * @brief FilterRanger
+         *
+         * Pushes the elements `x` of `rng` for which `pred(x)` holds.
+         *
+         * @tparam P
+         * @tparam R
+         */
+        template <typename P, typename R> struct FilterRanger {
+            using ranger_tag = void;
+
+            mutable P pred;
+            R rng;
+
+            template <typename Sink> auto operator()(Sink &sink) const -> bool {
+                auto &pred = this->pred;
+                auto stage = [&pred, &sink](auto &&x) -> bool {
+                    return pred(x) ? sink(std::forward<decltype(x)>(x)) : true;
+                };
+                return this->rng(stage);
+            }
+        };
+
+        /**
+         * @brief TakeRanger
+         *
+         * Pushes the first `n` elements of `rng`. It stops its source after the
+         * `n`-th element, and then counts as having run to the end.
+         *
+         * @tparam R
+         */
+        template <typename R> struct TakeRanger {
+            using ranger_tag = void;
+
+            size_t n;
+            R rng;
+
+            template <typename Sink> auto operator()(Sink &sink) const -> bool {
+                auto left = this->n;
+                if (left == 0) {
+                    return true;
+                }
+                auto stopped = false;
+                auto stage = [&left, &stopped, &sink](auto &&x) -> bool {
+                    if (!sink(std::forward<decltype(x)>(x))) {
+                        stopped = true;
+                        return false;
+                    }
+                    return --left != 0;
+                };
+                this->rng(stage);
+                return !stopped;
+            }
+        };
+
+        /**
+         * @brief RefRanger
+         *
+         * Refers to an lvalue stage, so that a stage that is stored in a variable
+         * is not copied (with the containers it owns) each time it is run or
+         * extended, the same way `SourceRanger` refers to lvalue iterables.
+         *
+         * @tparam R
+         */
+        template <typename R> struct RefRanger {
+            using ranger_tag = void;
+
+            std::reference_wrapper<const R> rng;
+
+            template <typename Sink> auto operator()(Sink &sink) const -> bool {
+                return this->rng.get()(sink);
+            }
+        };
+
+        template <typename T>
+        auto stored_ranger(T &rng, std::true_type /* lvalue */) -> RefRanger<T> {
+            return RefRanger<T>{rng};
+        }
+
+        template <typename T> auto stored_ranger(T &&rng, std::false_type /* lvalue */) -> T {
+            return std::move(rng);
+        }
+
+        template <typename T>
+        auto as_ranger(T &&rng, std::true_type /* ranger */)
+            -> decltype(stored_ranger(std::forward<T>(rng), std::is_lvalue_reference<T>{})) {
+            return stored_ranger(std::forward<T>(rng), std::is_lvalue_reference<T>{});
+        }
+
+        template <typename T>
+        auto as_ranger(T &&iterable, std::false_type /* ranger */) -> SourceRanger<T> {
+            return SourceRanger<T>{std::forward<T>(iterable)};
+        }
+
+        template <typename T>
+        using ranger_t = decltype(as_ranger(std::declval<T>(), is_ranger<T>{}));
+
+    }  // namespace detail
+
+    /**
+     * @brief source(iterable)
+     *
+     * The `source()` function turns an iterable into the source stage of a
+     * pipeline. `map()`, `filter()`, `take()` and `accumulate()` call it
+     * implicitly, so it is rarely needed.
+     *
+     * @tparam T
+     * @param[in] iterable
+     * @return detail::SourceRanger<T>
+     */
+    template <typename T> inline auto source(T &&iterable) -> detail::SourceRanger<T> {
+        return detail::SourceRanger<T>{std::forward<T>(iterable)};
+    }
+
+    /**
+     * @brief map(f, rng)
+     *
+     * A stage that yields `f(x)` for each element `x` of `rng`, as Python's
+     * `map(f, rng)`. `rng` is a pipeline stage or an iterable; the new stage
+     * refers to an lvalue `rng` and owns an rvalue one.
+     *
+     * @tparam F
+     * @tparam R
+     * @param[in] f
+     * @param[in] rng
+     * @return detail::MapRanger
+     */
+    template <typename F, typename R> inline auto map(F &&f, R &&rng)
+        -> detail::MapRanger<typename std::decay<F>::type, detail::ranger_t<R>> {
+        return {std::forward<F>(f),
+                detail::as_ranger(std::forward<R>(rng), detail::is_ranger<R>{})};
+    }
+
+    /**
+     * @brief filter(pred, rng)
+     *
+     * A stage that yields the elements `x` of `rng` for which `pred(x)` holds,
+     * as Python's `filter(pred, rng)`.
+     *
+     * @tparam P
+     * @tparam R
+     * @param[in] pred
+     * @param[in] rng
+     * @return detail::FilterRanger
+     */
+    template <typename P, typename R> inline auto filter(P &&pred, R &&rng)
+        -> detail::FilterRanger<typename std::decay<P>::type, detail::ranger_t<R>> {
+        return {std::forward<P>(pred),
+                detail::as_ranger(std::forward<R>(rng), detail::is_ranger<R>{})};
+    }
+
+    /**
+     * @brief take(n, rng)
+     *
+     * A stage that yields the first `n` elements of `rng`, as
+     * `itertools.islice(rng, n)`. The elements after them are not computed.
+     *
+     * @tparam R
+     * @param[in] n
+     * @param[in] rng
+     * @return detail::TakeRanger
+     */
+    template <typename R>
+    inline auto take(size_t n, R &&rng) -> detail::TakeRanger<detail::ranger_t<R>> {
+        return {n, detail::as_ranger(std::forward<R>(rng), detail::is_ranger<R>{})};
+    }
+
+    /**
+     * @brief accumulate(rng, init)
+     *
+     * Runs the pipeline `rng` and returns `init + x0 + x1 + ...`, as
+     * `std::accumulate`.
+     *
+     * @tparam R
+     * @tparam T
+     * @param[in] rng
+     * @param[in] init
+     * @return T
+     */
+    template <typename R, typename T> inline auto accumulate(R &&rng, T init) -> T {
+        auto source = detail::as_ranger(std::forward<R>(rng), detail::is_ranger<R>{});
+        auto sink = [&init](auto &&x) -> bool {
+            init = std::move(init) + x;
+            return true;
+        };
+        source(sink);
+        return init;
+    }
+
+    /**
+     * @brief for_each(rng, f)
+     *
+     * Runs the pipeline `rng` and calls `f(x)` for each of its elements.
+     *
+     * @tparam R
+     * @tparam F
+     * @param[in] rng
+     * @param[in] f
+     */
+    template <typename R, typename F> inline void for_each(R &&rng, F &&f) {
+        auto source = detail::as_ranger(std::forward<R>(rng), detail::is_ranger<R>{});
+        auto sink = [&f](auto &&x) -> bool {
+            f(std::forward<decltype(x)>(x));
+            return true;
+        };
+        source(sink);
+    }
+
+}  // namespace py
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>      // import size_t, std::nullptr_t
+#include <iterator>     // import std::iterator_traits, std::begin, std::end
+#include <type_traits>  // import std::conditional, std::is_same, std::integral_constant
+#include <utility>      // import std::pair, std::declval, std::forward
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#    include <xmmintrin.h>  // import _mm_prefetch
+#endif
+
+#include "iterator.hpp"
+
+/**
+ * @brief PYRANGE_PREFETCH_DISTANCE
+ *
+ * How many elements ahead `prefetched()` loads when no distance is given. A
+ * cache miss costs about 100 ns; with a few nanoseconds of work per element,
+ * 16 elements ahead is enough to hide it on current CPUs. Define it before
+ * including this header to override the choice for a machine or a workload.
+ */
+#ifndef PYRANGE_PREFETCH_DISTANCE
+#    define PYRANGE_PREFETCH_DISTANCE 16
+#endif
+
+namespace py {
+
+    namespace detail {
+
+        inline void prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+            static_cast<void>(address);
+#endif
+        }
+
+        inline void prefetch(std::nullptr_t /* unused */) {}
+
+        template <typename T> auto prefetch_pointee(T *const &x) -> const void * { return x; }
+
+        template <typename T> auto prefetch_pointee(const T & /* unused */) -> std::nullptr_t {
+            return nullptr;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief PrefetchTarget
+     *
+     * The address `prefetched()` loads ahead by default: the object that a loop
+     * body reaches through a pointer. For a pointer held by a container, such
+     * as an element of `std::vector<T *>` (an lvalue), that is its pointee; for
+     * an element `p` of `range(ptr_begin, ptr_end)` over an array of pointers
+     * (a prvalue) it is `*p`; for a pair of `enumerate()` over an array of
+     * pointers it is the pointer in the pair. Everything else is left alone
+     * (the `std::nullptr_t` overloads): the elements of a contiguous array,
+     * including the `T *` of `range(ptr_begin, ptr_end)` over one, are already
+     * fetched by the hardware, and integers such as those of `range(n)` point
+     * nowhere. For a gather through an index array, pass the address of what
+     * the loop reads instead, e.g. `[&](int i) { return &data[i]; }`.
+     */
+    struct PrefetchTarget {
+        template <typename T> auto operator()(T *const &p) const -> const void * { return p; }
+
+        template <typename T> auto operator()(T **&&p) const -> const void * { return *p; }
+
+        template <typename T> auto operator()(T *const *&&p) const -> const void * { return *p; }
+
+        template <typename T> auto operator()(T *&& /* unused */) const -> std::nullptr_t {
+            return nullptr;
+        }
+
+        template <typename I, typename R>
+        auto operator()(const std::pair<I, R> &p) const
+            -> decltype(detail::prefetch_pointee(p.second)) {
+            return detail::prefetch_pointee(p.second);
+        }
+
+        template <typename T> auto operator()(const T & /* unused */) const -> std::nullptr_t {
+            return nullptr;
+        }
+    };
+
+    /**
+     * @brief PrefetchIterator
+     *
+     * Wraps a random-access iterator `it` and keeps a second one, `ahead`,
+     * `distance` elements further on. Every step forward prefetches the element
+     * at `ahead` and moves it on, until it reaches the end. It points to the
+     * `addr` of its range, which must outlive it, so that it stays assignable
+     * if `addr` is a lambda.
+     *
+     * @tparam Iter
+     * @tparam Addr
+     */
+    template <typename Iter, typename Addr>
+    struct PrefetchIterator
+        : detail::RandomAccessOps<PrefetchIterator<Iter, Addr>,
+                                  decltype(*std::declval<const Iter &>()),
+                                  typename std::iterator_traits<Iter>::difference_type> {
+        using iterator_category = typename std::iterator_traits<Iter>::iterator_category;
+        using difference_type = typename std::iterator_traits<Iter>::difference_type;
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+        using reference = decltype(*std::declval<const Iter &>());
+        using pointer = void;
+
+        // false if `addr` yields `std::nullptr_t`: then nothing is prefetched
+        // and the iterator steps like `Iter`, so contiguous scans still vectorize
+        static constexpr bool active = !std::is_same<
+            decltype(std::declval<const Addr &>()(*std::declval<const Iter &>())),
+            std::nullptr_t>::value;
+
+        Iter it{};
+        Iter ahead{};
+        Iter last{};
+        const Addr *addr = nullptr;
+        difference_type distance = 0;
+
+        PrefetchIterator() = default;
+        PrefetchIterator(Iter it, Iter ahead, Iter last, const Addr *addr,
+                         difference_type distance)
+            : it(it), ahead(ahead), last(last), addr(addr), distance(distance) {}
+
+        void step_ahead(std::true_type /* active */) {
+            if (this->ahead != this->last) {
+                detail::prefetch((*this->addr)(*this->ahead));
+                ++this->ahead;
+            }
+        }
+
+        void step_ahead(std::false_type /* inactive */) {}
+
+        auto operator*() const -> reference { return *this->it; }
+
+        void increment() {
+            ++this->it;
+            this->step_ahead(std::integral_constant<bool, active>{});
+        }
+
+        void advance(difference_type n) {
+            this->it = this->it + n;
+            const auto rest = this->last - this->it;
+            this->ahead = this->it + (rest < this->distance ? rest : this->distance);
+        }
+
+        auto distance_from(const PrefetchIterator &other) const -> difference_type {
+            return this->it - other.it;
+        }
+
+        auto equal(const PrefetchIterator &other) const -> bool { return this->it == other.it; }
+    };
+
+    /**
+     * @brief PrefetchedRange
+     *
+     * The range returned by `prefetched()`. It owns an rvalue range and refers
+     * to an lvalue one, like `enumerate()`.
+     *
+     * @tparam T
+     * @tparam Addr
+     */
+    template <typename T, typename Addr> struct PrefetchedRange {
+        // a referred range stays mutable through a const `PrefetchedRange`, an owned one does not
+        using access_type =
+            typename std::conditional<std::is_lvalue_reference<T>::value, T, const T &>::type;
+        using base_iterator = decltype(std::begin(std::declval<access_type>()));
+        using iterator = PrefetchIterator<base_iterator, Addr>;
+        using value_type = typename iterator::value_type;
+
+        T rng;
+        size_t distance;
+        Addr addr;
+
+        /**
+         * @brief begin
+         *
+         * Also prefetches the first `distance` elements.
+         *
+         * @return iterator
+         */
+        auto begin() const -> iterator {
+            const auto first = std::begin(this->rng);
+            const auto last = std::end(this->rng);
+            auto ahead = first;
+            for (auto k = size_t(0); iterator::active && k < this->distance && ahead != last;
+                 ++k, ++ahead) {
+                detail::prefetch(this->addr(*ahead));
+            }
+            return iterator{first, ahead, last, &this->addr,
+                            static_cast<typename iterator::difference_type>(this->distance)};
+        }
+
+        auto end() const -> iterator {
+            const auto last = std::end(this->rng);
+            return iterator{last, last, last, &this->addr,
+                            static_cast<typename iterator::difference_type>(this->distance)};
+        }
+
+        auto size() const -> size_t { return static_cast<size_t>(this->end() - this->begin()); }
+
+        auto empty() const -> bool { return std::begin(this->rng) == std::end(this->rng); }
+    };
+
+    /**
+     * @brief prefetched(rng, distance, addr)
+     *
+     * The `prefetched()` function yields the same elements as `rng`, in the
+     * same order, and issues a software prefetch for the element `distance`
+     * steps ahead of the current one: loads through an array of pointers or an
+     * index array miss the cache on almost every element and the hardware
+     * prefetcher cannot predict them. It suits a `std::vector<T *>`,
+     * `range(ptr_begin, ptr_end)`, `enumerate()` (in either order of the two)
+     * and other random-access ranges, and can be split across threads by
+     * `parallel_for`. A zero
+     * `distance` stands for `PYRANGE_PREFETCH_DISTANCE`. With the default
+     * `addr`, a contiguous scan is not instrumented at all and compiles to the
+     * same loop as without `prefetched()`.
+     *
+     * @tparam T
+     * @tparam Addr
+     * @param[in] rng
+     * @param[in] distance
+     * @param[in] addr maps an element to the address to prefetch
+     * @return PrefetchedRange<T, Addr>
+     */
+    template <typename T, typename Addr = PrefetchTarget>
+    inline auto prefetched(T &&rng, size_t distance = 0, Addr addr = Addr{})
+        -> PrefetchedRange<T, Addr> {
+        return PrefetchedRange<T, Addr>{std::forward<T>(rng),
+                                        distance == 0 ? PYRANGE_PREFETCH_DISTANCE : distance,
+                                        addr};
+    }
+
+}  // namespace py
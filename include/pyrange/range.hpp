@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <type_traits>
 
@@ -12,19 +13,82 @@
 
 namespace py {
 
+    namespace detail {
+
+        template <typename T>
+        constexpr auto range_distance(T first, T last, std::true_type /* integral */)
+            -> std::ptrdiff_t {
+            return static_cast<std::ptrdiff_t>(static_cast<std::uintmax_t>(last)
+                                               - static_cast<std::uintmax_t>(first));
+        }
+
+        template <typename T>
+        constexpr auto range_distance(T first, T last, std::false_type /* pointer */)
+            -> std::ptrdiff_t {
+            return static_cast<std::ptrdiff_t>(last - first);
+        }
+
+        /**
+         * @brief range_distance(T first, T last)
+         *
+         * Returns `last - first` as a `std::ptrdiff_t`. Integral values are
+         * subtracted in the widest unsigned type so that the result is also correct
+         * when `last < first` for unsigned types that are not promoted to `int`
+         * (`unsigned int - unsigned int` would otherwise wrap at 32 bits).
+         *
+         * @tparam T
+         * @param[in] first
+         * @param[in] last
+         * @return std::ptrdiff_t
+         */
+        template <typename T> constexpr auto range_distance(T first, T last) -> std::ptrdiff_t {
+            return range_distance(first, last, std::is_integral<T>{});
+        }
+
+        /**
+         * @brief range_step<T>
+         *
+         * The signed type in which a `StepRange<T>` counts its steps. For integral
+         * types it is the signed counterpart of the promoted type, so that the
+         * value `start + k * step` is computed without a narrowing conversion and
+         * stays an affine function of the loop counter (which the auto-vectorizer
+         * requires). For pointers it is `std::ptrdiff_t`.
+         *
+         * @tparam T
+         */
+        template <typename T, bool = std::is_integral<T>::value> struct range_step {
+            using type = std::ptrdiff_t;
+        };
+
+        template <typename T> struct range_step<T, true> {
+            using type = typename std::make_signed<decltype(T() + T())>::type;
+        };
+
+    }  // namespace detail
+
     /**
-     * @brief
+     * @brief RangeIterator
+     *
+     * The `RangeIterator` struct is a random-access iterator that generates the
+     * values of a `Range` on the fly. Because the distance between two iterators
+     * can be computed in constant time, it can be handed to the parallel and
+     * vectorized algorithms of the standard library, which split the range into
+     * subranges by iterator arithmetic.
+     *
+     * The `difference_type` is always `std::ptrdiff_t`, so the distance stays
+     * correct for pointer ranges as well as for small integral types such as
+     * `char` (see `detail::range_distance`).
      *
      * @tparam T
      */
     template <typename T> struct RangeIterator {
-        using iterator_category = std::output_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
         using difference_type = std::ptrdiff_t;
         using value_type = T;
-        using pointer = T *;                // or also value_type*
-        using reference = T &;              // or also value_type&
-        using const_reference = const T &;  // or also value_type&
-        using key_type = T;                 // luk:
+        using pointer = void;
+        using reference = T;        // values are computed, not stored
+        using const_reference = T;  // so that temporaries can be dereferenced
+        using key_type = T;         // luk:
 
         T i;
 
@@ -65,22 +129,14 @@ namespace py {
          *
          * The code snippet you provided is defining the `operator*()` function for
          * the `RangeIterator` struct. This function is used to dereference the
-         * iterator and return the value it points to.
-         *
-         * @return const_reference
-         */
-        CONSTEXPR14 auto operator*() const -> const_reference { return this->i; }
-
-        /**
-         * @brief
-         *
-         * The code snippet you provided is defining the `operator*()` function for
-         * the `RangeIterator` struct. This function is used to dereference the
-         * iterator and return the value it points to.
+         * iterator and return the value it points to. The value is returned by
+         * copy, like `StepRangeIterator` does, so dereferencing a temporary
+         * iterator (`*std::make_reverse_iterator(rng.end())`, `begin()[n]`) does
+         * not leave a dangling reference to its member `i`.
          *
-         * @return reference
+         * @return value_type
          */
-        CONSTEXPR14 auto operator*() -> reference { return this->i; }
+        constexpr auto operator*() const -> value_type { return this->i; }
 
         /**
          * @brief
@@ -111,6 +167,171 @@ namespace py {
             ++(*this);
             return temp;
         }
+
+        /**
+         * @brief
+         *
+         * The pre-decrement operator (`operator--()`) moves the iterator to the
+         * previous element in the range.
+         *
+         * @return RangeIterator&
+         */
+        CONSTEXPR14 auto operator--() -> RangeIterator & {
+            --this->i;
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * The post-decrement operator (`operator--(int)`) moves the iterator to the
+         * previous element in the range, but returns a copy of the iterator before
+         * the decrement.
+         *
+         * @return RangeIterator
+         */
+        CONSTEXPR14 auto operator--(int) -> RangeIterator {
+            auto temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        /**
+         * @brief
+         *
+         * The compound assignment operator (`operator+=`) advances the iterator by
+         * `n` elements in constant time. A negative `n` moves the iterator
+         * backwards.
+         *
+         * @param[in] n
+         * @return RangeIterator&
+         */
+        CONSTEXPR14 auto operator+=(difference_type n) -> RangeIterator & {
+            this->i = static_cast<T>(this->i + n);
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * The compound assignment operator (`operator-=`) moves the iterator back
+         * by `n` elements in constant time.
+         *
+         * @param[in] n
+         * @return RangeIterator&
+         */
+        CONSTEXPR14 auto operator-=(difference_type n) -> RangeIterator & {
+            this->i = static_cast<T>(this->i - n);
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * Returns a copy of the iterator advanced by `n` elements.
+         *
+         * @param[in] n
+         * @return RangeIterator
+         */
+        constexpr auto operator+(difference_type n) const -> RangeIterator {
+            return RangeIterator{static_cast<T>(this->i + n)};
+        }
+
+        /**
+         * @brief
+         *
+         * Returns a copy of the iterator advanced by `n` elements.
+         *
+         * @param[in] n
+         * @param[in] it
+         * @return RangeIterator
+         */
+        friend constexpr auto operator+(difference_type n, const RangeIterator &it)
+            -> RangeIterator {
+            return it + n;
+        }
+
+        /**
+         * @brief
+         *
+         * Returns a copy of the iterator moved back by `n` elements.
+         *
+         * @param[in] n
+         * @return RangeIterator
+         */
+        constexpr auto operator-(difference_type n) const -> RangeIterator {
+            return RangeIterator{static_cast<T>(this->i - n)};
+        }
+
+        /**
+         * @brief
+         *
+         * Returns the number of elements between `other` and the current
+         * iterator.
+         *
+         * @param[in] other
+         * @return difference_type
+         */
+        constexpr auto operator-(const RangeIterator &other) const -> difference_type {
+            return detail::range_distance(other.i, this->i);
+        }
+
+        /**
+         * @brief
+         *
+         * Returns the value `n` elements past the current iterator. The value is
+         * computed rather than stored, so it is returned by value.
+         *
+         * @param[in] n
+         * @return value_type
+         */
+        constexpr auto operator[](difference_type n) const -> value_type {
+            return static_cast<T>(this->i + n);
+        }
+
+        /**
+         * @brief Less than
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator<(const RangeIterator &other) const -> bool {
+            return this->i < other.i;
+        }
+
+        /**
+         * @brief Greater than
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator>(const RangeIterator &other) const -> bool {
+            return other.i < this->i;
+        }
+
+        /**
+         * @brief Less than or equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator<=(const RangeIterator &other) const -> bool {
+            return !(other.i < this->i);
+        }
+
+        /**
+         * @brief Greater than or equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator>=(const RangeIterator &other) const -> bool {
+            return !(this->i < other.i);
+        }
     };
 
     /**
@@ -204,6 +425,319 @@ namespace py {
         constexpr auto contains(T n) const -> bool { return !(n < this->start) && n < this->stop; }
     };
 
+    /**
+     * @brief StepRangeIterator
+     *
+     * The `StepRangeIterator` struct is the random-access iterator of a
+     * `StepRange`. It counts the number of steps `k` taken from `start` and
+     * computes the current value as `start + k * step`. Because the loop
+     * variable is a plain counter that is incremented by one, the compiler
+     * knows the trip count of a range-based for loop just as it does for the
+     * unit-step `RangeIterator`, and can vectorize the loop body.
+     *
+     * @tparam T
+     */
+    template <typename T> struct StepRangeIterator {
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using step_type = typename detail::range_step<T>::type;
+        using value_type = T;
+        using pointer = void;
+        using reference = T;  // values are computed, not stored
+        using key_type = T;
+
+        T start;
+        step_type step;
+        step_type k;
+
+        /**
+         * @brief Not equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator!=(const StepRangeIterator &other) const -> bool {
+            return this->k != other.k;
+        }
+
+        /**
+         * @brief Equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator==(const StepRangeIterator &other) const -> bool {
+            return this->k == other.k;
+        }
+
+        /**
+         * @brief
+         *
+         * The `operator*()` function returns the value at the current position,
+         * that is `start + k * step`.
+         *
+         * @return value_type
+         */
+        constexpr auto operator*() const -> value_type {
+            return static_cast<T>(this->start + this->k * this->step);
+        }
+
+        /**
+         * @brief
+         *
+         * Returns the value `n` elements past the current iterator.
+         *
+         * @param[in] n
+         * @return value_type
+         */
+        constexpr auto operator[](difference_type n) const -> value_type {
+            return static_cast<T>(this->start
+                                  + (this->k + static_cast<step_type>(n)) * this->step);
+        }
+
+        /**
+         * @brief
+         *
+         * @return StepRangeIterator&
+         */
+        CONSTEXPR14 auto operator++() -> StepRangeIterator & {
+            ++this->k;
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * @return StepRangeIterator
+         */
+        CONSTEXPR14 auto operator++(int) -> StepRangeIterator {
+            auto temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        /**
+         * @brief
+         *
+         * @return StepRangeIterator&
+         */
+        CONSTEXPR14 auto operator--() -> StepRangeIterator & {
+            --this->k;
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * @return StepRangeIterator
+         */
+        CONSTEXPR14 auto operator--(int) -> StepRangeIterator {
+            auto temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        /**
+         * @brief
+         *
+         * @param[in] n
+         * @return StepRangeIterator&
+         */
+        CONSTEXPR14 auto operator+=(difference_type n) -> StepRangeIterator & {
+            this->k += static_cast<step_type>(n);
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * @param[in] n
+         * @return StepRangeIterator&
+         */
+        CONSTEXPR14 auto operator-=(difference_type n) -> StepRangeIterator & {
+            this->k -= static_cast<step_type>(n);
+            return *this;
+        }
+
+        /**
+         * @brief
+         *
+         * @param[in] n
+         * @return StepRangeIterator
+         */
+        constexpr auto operator+(difference_type n) const -> StepRangeIterator {
+            return StepRangeIterator{this->start, this->step,
+                                     static_cast<step_type>(this->k + n)};
+        }
+
+        /**
+         * @brief
+         *
+         * @param[in] n
+         * @param[in] it
+         * @return StepRangeIterator
+         */
+        friend constexpr auto operator+(difference_type n, const StepRangeIterator &it)
+            -> StepRangeIterator {
+            return it + n;
+        }
+
+        /**
+         * @brief
+         *
+         * @param[in] n
+         * @return StepRangeIterator
+         */
+        constexpr auto operator-(difference_type n) const -> StepRangeIterator {
+            return StepRangeIterator{this->start, this->step,
+                                     static_cast<step_type>(this->k - n)};
+        }
+
+        /**
+         * @brief
+         *
+         * @param[in] other
+         * @return difference_type
+         */
+        constexpr auto operator-(const StepRangeIterator &other) const -> difference_type {
+            return static_cast<difference_type>(this->k) - other.k;
+        }
+
+        /**
+         * @brief Less than
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator<(const StepRangeIterator &other) const -> bool {
+            return this->k < other.k;
+        }
+
+        /**
+         * @brief Greater than
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator>(const StepRangeIterator &other) const -> bool {
+            return other.k < this->k;
+        }
+
+        /**
+         * @brief Less than or equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator<=(const StepRangeIterator &other) const -> bool {
+            return !(other.k < this->k);
+        }
+
+        /**
+         * @brief Greater than or equal to
+         *
+         * @param[in] other
+         * @return true
+         * @return false
+         */
+        constexpr auto operator>=(const StepRangeIterator &other) const -> bool {
+            return !(this->k < other.k);
+        }
+    };
+
+    /**
+     * @brief StepRange
+     *
+     * The `StepRange` struct represents the Python range `range(start, stop,
+     * step)` for an arbitrary non-zero step, including negative steps. Instead of
+     * `stop` it stores the number of elements `len`, so that `size()`,
+     * `operator[]` and `contains()` are all constant time and no past-the-end
+     * value (which may not be representable, e.g. for pointers) is ever formed.
+     * The distance between `start` and `stop` must be representable in
+     * `step_type`.
+     *
+     * `Range<T>` remains the unit-step specialization and should be preferred
+     * when the step is known to be one.
+     *
+     * @tparam T
+     */
+    template <typename T> struct StepRange {
+      public:
+        using iterator = StepRangeIterator<T>;
+        using value_type = T;
+        using key_type = T;
+        using step_type = typename detail::range_step<T>::type;
+
+        T start;
+        step_type step;
+        step_type len;
+
+        /**
+         * @brief begin
+         *
+         * @return iterator
+         */
+        constexpr auto begin() const -> iterator {
+            return iterator{this->start, this->step, 0};
+        }
+
+        /**
+         * @brief end
+         *
+         * @return iterator
+         */
+        constexpr auto end() const -> iterator {
+            return iterator{this->start, this->step, this->len};
+        }
+
+        /**
+         * @brief empty
+         *
+         * @return true
+         * @return false
+         */
+        constexpr auto empty() const -> bool { return this->len == 0; }
+
+        /**
+         * @brief size
+         *
+         * @return size_t
+         */
+        constexpr auto size() const -> size_t { return static_cast<size_t>(this->len); }
+
+        /**
+         * @brief
+         *
+         * @param[in] n
+         * @return T
+         */
+        constexpr auto operator[](size_t n) const -> T {
+            return static_cast<T>(this->start + static_cast<step_type>(n) * this->step);
+        }  // no bounds checking
+
+        /**
+         * @brief
+         *
+         * The `contains()` function checks in constant time whether `n` is one of
+         * the values of the range, i.e. whether `n - start` is a multiple of `step`
+         * that lies within the first `len` steps.
+         *
+         * @param[in] n
+         * @return true
+         * @return false
+         */
+        constexpr auto contains(T n) const -> bool {
+            return this->len != 0 && detail::range_distance(this->start, n) % this->step == 0
+                   && detail::range_distance(this->start, n) / this->step >= 0
+                   && detail::range_distance(this->start, n) / this->step < this->len;
+        }
+    };
+
     /**
      * @brief range(T start, T stop)
      *
@@ -236,4 +770,65 @@ namespace py {
      */
     template <typename T> CONSTEXPR14 auto range(T stop) -> Range<T> { return range(T(0), stop); }
 
+    /**
+     * @brief range(T start, T stop, step_type step)
+     *
+     * The `range(T start, T stop, step)` function creates the values `start`,
+     * `start + step`, `start + 2 * step`, ... that lie before `stop`, just like
+     * Python's three-argument `range`. A negative `step` counts downwards; a
+     * zero `step` yields an empty range.
+     *
+     * @tparam T
+     * @param[in] start
+     * @param[in] stop
+     * @param[in] step
+     * @return StepRange<T>
+     */
+    template <typename T>
+    CONSTEXPR14 auto range(T start, T stop, typename detail::range_step<T>::type step)
+        -> StepRange<T> {
+        const auto dist = detail::range_distance(start, stop);
+        auto len = std::ptrdiff_t(0);
+        if (step > 0 && dist > 0) {
+            len = (dist - 1) / step + 1;
+        } else if (step < 0 && dist < 0) {
+            len = (dist + 1) / step + 1;
+        }
+        return StepRange<T>{start, step, static_cast<decltype(step)>(len)};
+    }
+
+    /**
+     * @brief reversed(const Range<T> &rng)
+     *
+     * Returns the values of `rng` in reverse order, like Python's
+     * `reversed(range(start, stop))`.
+     *
+     * @tparam T
+     * @param[in] rng
+     * @return StepRange<T>
+     */
+    template <typename T> CONSTEXPR14 auto reversed(const Range<T> &rng) -> StepRange<T> {
+        if (rng.empty()) {
+            return StepRange<T>{rng.start, -1, 0};
+        }
+        using step_type = typename StepRange<T>::step_type;
+        return StepRange<T>{*(rng.end() - 1), -1, static_cast<step_type>(rng.size())};
+    }
+
+    /**
+     * @brief reversed(const StepRange<T> &rng)
+     *
+     * Returns the values of `rng` in reverse order.
+     *
+     * @tparam T
+     * @param[in] rng
+     * @return StepRange<T>
+     */
+    template <typename T> CONSTEXPR14 auto reversed(const StepRange<T> &rng) -> StepRange<T> {
+        if (rng.empty()) {
+            return StepRange<T>{rng.start, -rng.step, 0};
+        }
+        return StepRange<T>{*(rng.end() - 1), -rng.step, rng.len};
+    }
+
 }  // namespace py
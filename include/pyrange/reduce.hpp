@@ -0,0 +1,486 @@
+#pragma once
+
+#include <algorithm>    // import std::max, std::min, std::sort
+#include <array>        // import std::array
+#include <cstddef>      // import size_t
+#include <cstdint>      // import std::uintmax_t
+#include <functional>   // import std::plus
+#include <iterator>     // import std::begin() std::end()
+#include <mutex>        // import std::mutex
+#include <type_traits>  // import std::enable_if
+#include <utility>      // import std::index_sequence
+#include <vector>       // import std::vector
+
+#include "parallel.hpp"
+#include "range.hpp"
+
+namespace py {
+
+    namespace detail {
+
+        // below this many elements an adaptive reduction stays on the calling
+        // thread
+        constexpr std::ptrdiff_t parallel_reduce_threshold = std::ptrdiff_t(1) << 15;
+
+        // independent accumulators of a sequential reduction: they break the
+        // dependency chain of `acc = op(acc, x)` and let the compiler keep them
+        // in one or two vector registers
+        constexpr std::ptrdiff_t reduce_lanes = 8;
+
+        template <typename Rng>
+        using range_value_t =
+            typename std::decay<decltype(*std::begin(std::declval<const Rng &>()))>::type;
+
+        struct Identity {
+            template <typename X> auto operator()(X &&x) const -> X && {
+                return std::forward<X>(x);
+            }
+        };
+
+        template <typename T, typename Iter, typename Proj, size_t... I>
+        auto load_lanes(Iter first, Proj &proj, std::index_sequence<I...> /* unused */)
+            -> std::array<T, sizeof...(I)> {
+            return std::array<T, sizeof...(I)>{{T(proj(first[I]))...}};
+        }
+
+        template <typename Iter, typename T, typename Op, typename Proj>
+        auto reduce_seq(Iter first, Iter last, T init, Op &op, Proj &proj,
+                        std::input_iterator_tag /* category */) -> T {
+            for (; first != last; ++first) {
+                init = op(std::move(init), proj(*first));
+            }
+            return init;
+        }
+
+        /**
+         * @brief reduce_seq
+         *
+         * Reduces `[first, last)` on the calling thread with `reduce_lanes`
+         * accumulators, each of which takes every `reduce_lanes`-th element. The
+         * accumulators are combined pairwise at the end. The order of the
+         * operations depends only on the number of elements.
+         */
+        template <typename Iter, typename T, typename Op, typename Proj>
+        auto reduce_seq(Iter first, Iter last, T init, Op &op, Proj &proj,
+                        std::random_access_iterator_tag /* category */) -> T {
+            const auto n = static_cast<std::ptrdiff_t>(last - first);
+            if (n < 2 * reduce_lanes) {
+                return reduce_seq(first, last, std::move(init), op, proj,
+                                  std::input_iterator_tag{});
+            }
+            auto acc = load_lanes<T>(first, proj, std::make_index_sequence<reduce_lanes>{});
+            auto i = reduce_lanes;
+            for (; i + reduce_lanes <= n; i += reduce_lanes) {
+                for (std::ptrdiff_t j = 0; j != reduce_lanes; ++j) {
+                    acc[size_t(j)] = op(std::move(acc[size_t(j)]), proj(first[i + j]));
+                }
+            }
+            for (auto width = reduce_lanes / 2; width != 0; width /= 2) {
+                for (std::ptrdiff_t j = 0; j != width; ++j) {
+                    acc[size_t(j)]
+                        = op(std::move(acc[size_t(j)]), std::move(acc[size_t(j + width)]));
+                }
+            }
+            init = op(std::move(init), std::move(acc[0]));
+            return reduce_seq(first + i, last, std::move(init), op, proj,
+                              std::input_iterator_tag{});
+        }
+
+        template <typename Iter, typename T, typename Op, typename Proj>
+        auto reduce_seq(Iter first, Iter last, T init, Op &op, Proj &proj) -> T {
+            return reduce_seq(first, last, std::move(init), op, proj,
+                              typename std::iterator_traits<Iter>::iterator_category{});
+        }
+
+        // a block is never empty, its first element seeds the reduction
+        template <typename Iter, typename T, typename Op, typename Proj>
+        auto reduce_block(Iter first, Iter last, Op &op, Proj &proj) -> T {
+            return reduce_seq(first + 1, last, T(proj(*first)), op, proj);
+        }
+
+        template <typename Rng, typename T, typename Op, typename Proj>
+        auto reduce(ThreadPool &pool, const Rng &rng, T init, Op op, Proj proj, Partition partition,
+                    std::input_iterator_tag /* category */) -> T {
+            static_cast<void>(pool);
+            static_cast<void>(partition);
+            return reduce_seq(std::begin(rng), std::end(rng), std::move(init), op, proj);
+        }
+
+        /**
+         * @brief reduce
+         *
+         * With `Partition::Adaptive`, small ranges are reduced on the calling
+         * thread and large ones are split by `parallel_for_chunk`; the partial
+         * results are combined from left to right.
+         *
+         * With `Partition::Deterministic`, the range is always cut into blocks of
+         * `deterministic_grain` elements, each block is reduced by `reduce_seq` and
+         * the block results are combined from left to right. The order of the
+         * floating-point operations then depends on the number of elements only,
+         * not on the number of threads or on the scheduling.
+         */
+        template <typename Rng, typename T, typename Op, typename Proj>
+        auto reduce(ThreadPool &pool, const Rng &rng, T init, Op op, Proj proj, Partition partition,
+                    std::random_access_iterator_tag /* category */) -> T {
+            using Iter = decltype(std::begin(rng));
+            const auto first = std::begin(rng);
+            const auto last = std::end(rng);
+            const auto n = static_cast<std::ptrdiff_t>(split_distance(first, last));
+            if (n == 0) {
+                return init;
+            }
+
+            if (partition == Partition::Deterministic) {
+                const auto grain = static_cast<std::ptrdiff_t>(deterministic_grain);
+                const auto blocks = (n + grain - 1) / grain;
+                auto partials = std::vector<T>();
+                partials.reserve(size_t(blocks));
+                if (n < parallel_reduce_threshold) {
+                    for (std::ptrdiff_t b = 0; b != blocks; ++b) {
+                        partials.push_back(reduce_block<Iter, T>(
+                            first + b * grain, first + std::min(n, (b + 1) * grain), op, proj));
+                    }
+                } else {
+                    // every piece is exactly one block, see ForkJoin
+                    partials.assign(size_t(blocks), init);
+                    parallel_for_chunk(
+                        pool, rng,
+                        [&](const SubRange<Iter> &sub) {
+                            partials[size_t((sub.first - first) / grain)]
+                                = reduce_block<Iter, T>(sub.first, sub.last, op, proj);
+                        },
+                        deterministic_grain, Partition::Deterministic);
+                }
+                for (auto &partial : partials) {
+                    init = op(std::move(init), std::move(partial));
+                }
+                return init;
+            }
+
+            if (n < parallel_reduce_threshold || pool.num_threads() == 1) {
+                return reduce_seq(first, last, std::move(init), op, proj);
+            }
+            auto partials = std::vector<std::pair<std::ptrdiff_t, T>>();
+            std::mutex mutex;
+            parallel_for_chunk(
+                pool, rng,
+                [&](const SubRange<Iter> &sub) {
+                    auto partial = reduce_block<Iter, T>(sub.first, sub.last, op, proj);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    partials.emplace_back(sub.first - first, std::move(partial));
+                },
+                0, Partition::Adaptive);
+            std::sort(partials.begin(), partials.end(),
+                      [](const std::pair<std::ptrdiff_t, T> &a,
+                         const std::pair<std::ptrdiff_t, T> &b) { return a.first < b.first; });
+            for (auto &partial : partials) {
+                init = op(std::move(init), std::move(partial.second));
+            }
+            return init;
+        }
+
+        template <typename Rng, typename T, typename Op, typename Proj>
+        auto reduce(ThreadPool &pool, const Rng &rng, T init, Op op, Proj proj, Partition partition)
+            -> T {
+            using Iter = decltype(std::begin(rng));
+            return reduce(pool, rng, std::move(init), op, proj, partition,
+                          typename std::iterator_traits<Iter>::iterator_category{});
+        }
+
+        // n * (n - 1) / 2, modulo 2^bits
+        constexpr auto triangular(std::uintmax_t n) -> std::uintmax_t {
+            return n % 2 == 0 ? n / 2 * (n - 1) : (n - 1) / 2 * n;
+        }
+
+        // start * len + step * len * (len - 1) / 2, computed modulo 2^bits like
+        // the element-by-element sum of integers
+        template <typename U, typename T>
+        constexpr auto affine_sum(T start, std::intmax_t step, std::uintmax_t len,
+                                  std::true_type /* integral */) -> U {
+            return static_cast<U>(
+                static_cast<std::uintmax_t>(static_cast<std::intmax_t>(start)) * len
+                + static_cast<std::uintmax_t>(step) * triangular(len));
+        }
+
+        // len * (first + last) / 2 in floating point, which does not wrap around
+        // like the element-by-element floating-point sum
+        template <typename U, typename T>
+        constexpr auto affine_sum(T start, std::intmax_t step, std::uintmax_t len,
+                                  std::false_type /* integral */) -> U {
+            return len == 0 ? U(0)
+                            : static_cast<U>(len)
+                                  * (static_cast<U>(start)
+                                     + (static_cast<U>(start)
+                                        + static_cast<U>(step) * static_cast<U>(len - 1)))
+                                  / 2;
+        }
+
+        template <typename U, typename T>
+        constexpr auto affine_sum(T start, std::intmax_t step, std::uintmax_t len) -> U {
+            return affine_sum<U>(start, step, len, std::is_integral<U>{});
+        }
+
+        // floor and ceiling of a / b for b > 0
+        constexpr auto floor_div(std::ptrdiff_t a, std::ptrdiff_t b) -> std::ptrdiff_t {
+            return a >= 0 ? a / b : -((-a + b - 1) / b);
+        }
+
+        constexpr auto ceil_div(std::ptrdiff_t a, std::ptrdiff_t b) -> std::ptrdiff_t {
+            return -floor_div(-a, b);
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief reduce(pool, rng, init, op, partition)
+     *
+     * The `reduce` function returns `init` combined with all the elements of
+     * `rng` by `op`, like `std::reduce`: `op` must be associative and
+     * commutative, because the elements are not combined from left to right.
+     * On the calling thread, a random-access range is reduced with several
+     * independent accumulators, which lets the compiler vectorize the loop.
+     * Ranges of more than 32768 elements are split across the threads of
+     * `pool`.
+     *
+     * With `Partition::Deterministic` the grouping of the operations depends
+     * only on the size of `rng`, so that floating-point results are
+     * reproducible across thread counts and runs.
+     *
+     * @tparam Rng
+     * @tparam T
+     * @tparam Op
+     * @param[in] pool
+     * @param[in] rng
+     * @param[in] init
+     * @param[in] op
+     * @param[in] partition
+     * @return T
+     */
+    template <typename Rng, typename T, typename Op>
+    auto reduce(ThreadPool &pool, const Rng &rng, T init, Op op,
+                Partition partition = Partition::Adaptive) -> T {
+        return detail::reduce(pool, rng, std::move(init), op, detail::Identity{}, partition);
+    }
+
+    /**
+     * @brief reduce(rng, init, op, partition)
+     *
+     * Same as above, on `ThreadPool::global()`.
+     *
+     * @tparam Rng
+     * @tparam T
+     * @tparam Op
+     * @param[in] rng
+     * @param[in] init
+     * @param[in] op
+     * @param[in] partition
+     * @return T
+     */
+    template <typename Rng, typename T, typename Op>
+    auto reduce(const Rng &rng, T init, Op op, Partition partition = Partition::Adaptive) -> T {
+        return reduce(ThreadPool::global(), rng, std::move(init), op, partition);
+    }
+
+    /**
+     * @brief sum(rng, init, partition)
+     *
+     * Returns `init` plus the sum of the elements of `rng`, as Python's
+     * `sum(rng, init)`. The sum is computed by `reduce()`.
+     *
+     * @tparam Rng
+     * @tparam T
+     * @param[in] rng
+     * @param[in] init
+     * @param[in] partition
+     * @return T
+     */
+    template <typename Rng, typename T>
+    auto sum(const Rng &rng, T init, Partition partition = Partition::Adaptive) -> T {
+        return reduce(rng, std::move(init), std::plus<>{}, partition);
+    }
+
+    /**
+     * @brief sum(rng, init)
+     *
+     * Sum of an integral `Range`, in constant time. For an integral `init`
+     * the result is the one of the element-by-element sum in the type of
+     * `init`, including its wrap-around for unsigned types. For a
+     * floating-point `init` it is `len * (first + last) / 2`, computed in the
+     * type of `init`.
+     *
+     * @tparam T
+     * @tparam U
+     * @param[in] rng
+     * @param[in] init
+     * @param[in] partition unused
+     * @return U
+     */
+    template <typename T, typename U,
+              typename = typename std::enable_if<std::is_integral<T>::value
+                                                 && std::is_arithmetic<U>::value>::type>
+    CONSTEXPR14 auto sum(const Range<T> &rng, U init, Partition partition = Partition::Adaptive)
+        -> U {
+        static_cast<void>(partition);
+        return static_cast<U>(init + detail::affine_sum<U>(rng.start, 1, rng.size()));
+    }
+
+    /**
+     * @brief sum(rng, init)
+     *
+     * Sum of an integral `StepRange`, in constant time.
+     *
+     * @tparam T
+     * @tparam U
+     * @param[in] rng
+     * @param[in] init
+     * @param[in] partition unused
+     * @return U
+     */
+    template <typename T, typename U,
+              typename = typename std::enable_if<std::is_integral<T>::value
+                                                 && std::is_arithmetic<U>::value>::type>
+    CONSTEXPR14 auto sum(const StepRange<T> &rng, U init,
+                         Partition partition = Partition::Adaptive) -> U {
+        static_cast<void>(partition);
+        return static_cast<U>(init + detail::affine_sum<U>(rng.start, rng.step, rng.size()));
+    }
+
+    /**
+     * @brief sum(rng)
+     *
+     * Returns the sum of the elements of `rng`, starting from a
+     * value-initialized element.
+     *
+     * @tparam Rng
+     * @param[in] rng
+     * @return detail::range_value_t<Rng>
+     */
+    template <typename Rng> auto sum(const Rng &rng) -> detail::range_value_t<Rng> {
+        return sum(rng, detail::range_value_t<Rng>{});
+    }
+
+    /**
+     * @brief count_if(rng, pred, partition)
+     *
+     * Returns the number of elements `x` of `rng` for which `pred(x)` holds.
+     * Like `reduce()`, it runs in parallel on large random-access ranges.
+     *
+     * @tparam Rng
+     * @tparam Pred
+     * @param[in] rng
+     * @param[in] pred
+     * @param[in] partition
+     * @return size_t
+     */
+    template <typename Rng, typename Pred>
+    auto count_if(const Rng &rng, Pred pred, Partition partition = Partition::Adaptive) -> size_t {
+        const auto hit = [&pred](const auto &x) -> size_t { return pred(x) ? 1 : 0; };
+        return detail::reduce(ThreadPool::global(), rng, size_t(0), std::plus<>{}, hit, partition);
+    }
+
+    /**
+     * @brief count_if(rng, window)
+     *
+     * Returns the number of elements of `rng` for which `window.contains(x)`
+     * holds, i.e. the size of the intersection of the two ranges, in constant
+     * time.
+     *
+     * @tparam T
+     * @param[in] rng
+     * @param[in] window
+     * @param[in] partition unused
+     * @return size_t
+     */
+    template <typename T>
+    CONSTEXPR14 auto count_if(const Range<T> &rng, const Range<T> &window,
+                              Partition partition = Partition::Adaptive) -> size_t {
+        static_cast<void>(partition);
+        if (rng.empty() || window.empty()) {
+            return 0;
+        }
+        const auto lo = std::max(rng.start, window.start);
+        const auto hi = std::min(rng.stop, window.stop);
+        return lo < hi ? static_cast<size_t>(detail::range_distance(lo, hi)) : 0;
+    }
+
+    /**
+     * @brief count_if(rng, window)
+     *
+     * Returns the number of elements of the `StepRange` `rng` for which
+     * `window.contains(x)` holds, in constant time.
+     *
+     * @tparam T
+     * @param[in] rng
+     * @param[in] window
+     * @param[in] partition unused
+     * @return size_t
+     */
+    template <typename T>
+    CONSTEXPR14 auto count_if(const StepRange<T> &rng, const Range<T> &window,
+                              Partition partition = Partition::Adaptive) -> size_t {
+        static_cast<void>(partition);
+        if (rng.len == 0 || window.empty()) {
+            return 0;
+        }
+        // the steps k of `start + k * step` that fall into [window.start, window.stop)
+        const auto to_lo = detail::range_distance(rng.start, window.start);
+        const auto to_hi = detail::range_distance(rng.start, window.stop);
+        const auto step = static_cast<std::ptrdiff_t>(rng.step);
+        auto k_first = std::ptrdiff_t(0);
+        auto k_last = std::ptrdiff_t(0);
+        if (step > 0) {
+            k_first = detail::ceil_div(to_lo, step);
+            k_last = detail::ceil_div(to_hi, step);
+        } else {
+            k_first = detail::floor_div(-to_hi, -step) + 1;
+            k_last = detail::floor_div(-to_lo, -step) + 1;
+        }
+        k_first = std::max(k_first, std::ptrdiff_t(0));
+        k_last = std::min(k_last, static_cast<std::ptrdiff_t>(rng.len));
+        return k_first < k_last ? static_cast<size_t>(k_last - k_first) : 0;
+    }
+
+    /**
+     * @brief count(rng, value)
+     *
+     * Returns the number of elements of `rng` that are equal to `value`.
+     *
+     * @tparam Rng
+     * @tparam T
+     * @param[in] rng
+     * @param[in] value
+     * @return size_t
+     */
+    template <typename Rng, typename T> auto count(const Rng &rng, const T &value) -> size_t {
+        return count_if(rng, [&value](const auto &x) { return x == value; });
+    }
+
+    /**
+     * @brief count(rng, value)
+     *
+     * For a `Range`, in constant time: its elements are distinct.
+     *
+     * @tparam T
+     * @param[in] rng
+     * @param[in] value
+     * @return size_t
+     */
+    template <typename T> constexpr auto count(const Range<T> &rng, T value) -> size_t {
+        return rng.contains(value) ? 1 : 0;
+    }
+
+    /**
+     * @brief count(rng, value)
+     *
+     * For a `StepRange`, in constant time.
+     *
+     * @tparam T
+     * @param[in] rng
+     * @param[in] value
+     * @return size_t
+     */
+    template <typename T> constexpr auto count(const StepRange<T> &rng, T value) -> size_t {
+        return rng.contains(value) ? 1 : 0;
+    }
+
+}  // namespace py
@@ -1,24 +1,37 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>  // import std::make_heap, std::push_heap, std::pop_heap
+#include <atomic>     // import std::atomic
+#include <cassert>    // import assert
+#include <cstddef>    // import size_t
+#include <cstdint>    // import uint64_t
+#include <utility>    // import std::move
+#include <vector>     // import std::vector
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>  // import _BitScanForward64
+#endif
 
 namespace fun {
 
     namespace detail {
 
         /**
-         * @brief Singly linked list
+         * @brief Doubly linked list node
          *
-         * The code is defining a struct called `RobinSlNode` which represents a node in
-         * a singly linked list. It has two members: `next`, which is a pointer to the
-         * next node in the list, and `key`, which stores the value of the node. The
-         * template parameter `T` represents the type of the value stored in the node.
+         * The code is defining a struct called `RobinNode` which represents a node in
+         * the circular list of active parts of a `Robin`. The node of part `k` is
+         * stored at index `k` of the cycle, so the part itself is implied by the
+         * position of the node and the links are indices of type `T` rather than
+         * pointers. This keeps the node array compact (2 bytes per part for
+         * `Robin<uint8_t>`) and lets it be copied or relocated freely. The `prev`
+         * link is what allows a part to be unlinked in O(1).
          *
          * @tparam T
          */
-        template <typename T> struct RobinSlNode {
-            RobinSlNode *next;
-            T key;
+        template <typename T> struct RobinNode {
+            T next;
+            T prev;
         };
 
         /**
@@ -26,55 +39,60 @@ namespace fun {
          *
          * The code is defining a struct called `RobinIterator` which represents an
          * iterator for the `Robin` class. It is used to iterate over the elements in
-         * the round-robin cycle.
+         * the round-robin cycle. Besides the current part it keeps the number of
+         * parts that remain to be visited, which is what the end of the iteration
+         * is detected by.
          *
          * @tparam T
          */
         template <typename T> struct RobinIterator {
-            const RobinSlNode<T> *cur;
+            const RobinNode<T> *cycle;
+            T cur;
+            T remaining;
 
             /**
              * @brief Not equal to
              *
              * The code is defining the `operator!=` function for the `RobinIterator`
              * struct. This function is used to compare two `RobinIterator` objects for
-             * inequality. It takes another `RobinIterator` object `other` as a
-             * parameter and returns `true` if the `cur` member of the current object is
-             * not equal to the `cur` member of the `other` object, and `false`
-             * otherwise.
+             * inequality. Two iterators of the same iteration are different as long
+             * as they have a different number of parts left to visit.
              *
              * @param[in] other
              * @return true
              * @return false
              */
-            auto operator!=(const RobinIterator &other) const -> bool { return cur != other.cur; }
+            auto operator!=(const RobinIterator &other) const -> bool {
+                return remaining != other.remaining;
+            }
 
             /**
              * @brief Equal to
              *
              * The code is defining the `operator==` function for the `RobinIterator`
              * struct. This function is used to compare two `RobinIterator` objects for
-             * equality. It takes another `RobinIterator` object `other` as a parameter
-             * and returns `true` if the `cur` member of the current object is equal
-             * to the `cur` member of the `other` object, and `false` otherwise.
+             * equality.
              *
              * @param[in] other
              * @return true
              * @return false
              */
-            auto operator==(const RobinIterator &other) const -> bool { return cur == other.cur; }
+            auto operator==(const RobinIterator &other) const -> bool {
+                return remaining == other.remaining;
+            }
 
             /**
              * @brief
              *
              * The code is defining the `operator++` function for the `RobinIterator`
              * struct. This function is used to increment the iterator to the next
-             * element in the round-robin cycle.
+             * active part in the round-robin cycle.
              *
              * @return RobinIterator&
              */
             auto operator++() -> RobinIterator & {
-                cur = cur->next;
+                cur = cycle[cur].next;
+                --remaining;
                 return *this;
             }
 
@@ -82,29 +100,27 @@ namespace fun {
              * @brief
              *
              * The code is defining the `operator*` function for the `RobinIterator`
-             * struct. This function is used to dereference the iterator and return a
-             * reference to the value stored in the current node of the linked list. In
-             * this case, it returns a reference to the `key` member of the current
-             * node. The `const` qualifier indicates that the function does not modify
-             * the state of the iterator.
+             * struct. This function is used to dereference the iterator and return
+             * the current part.
              *
              * @return const T&
              */
-            auto operator*() const -> const T & { return cur->key; }
+            auto operator*() const -> const T & { return cur; }
         };
 
         /**
          * @brief RobinIterableWrapper
          *
          * The code is defining a struct called `RobinIterableWrapper` which is used as
-         * a wrapper for iterating over a round-robin cycle in the `Robin` class.
+         * a wrapper for iterating over a round-robin cycle in the `Robin` class. It
+         * visits `count` active parts, starting with part `first`.
          *
          * @tparam T
          */
         template <typename T> struct RobinIterableWrapper {
-            const detail::RobinSlNode<T> *node;
-            // const Robin<T> *rr;
-            // T from_part;
+            const detail::RobinNode<T> *cycle;
+            T first;
+            T count;
 
             /**
              * @brief begin
@@ -115,22 +131,442 @@ namespace fun {
              *
              * @return RobinIterator<T>
              */
-            auto begin() const -> RobinIterator<T> { return RobinIterator<T>{node->next}; }
+            auto begin() const -> RobinIterator<T> {
+                return RobinIterator<T>{cycle, first, count};
+            }
 
             /**
              * @brief
              *
              * The code is defining a member function called `end()` for the
              * `RobinIterableWrapper` struct. This function is used to return an
-             * iterator pointing to the end of the round-robin cycle. In this case, it
-             * returns a `RobinIterator` object initialized with the `node` member of
-             * the `RobinIterableWrapper` object. This iterator represents the end of
-             * the cycle and is used to determine when the iteration is complete.
+             * iterator pointing to the end of the round-robin cycle, i.e. an iterator
+             * with no parts left to visit.
              *
              * @return RobinIterator<T>
              */
-            auto end() const -> RobinIterator<T> { return RobinIterator<T>{node}; }
-            // auto size() const -> size_t { return rr->cycle.size() - 1; }
+            auto end() const -> RobinIterator<T> { return RobinIterator<T>{cycle, first, T(0)}; }
+        };
+
+        /**
+         * @brief count_trailing_zeros
+         *
+         * Returns the index of the lowest set bit of `x` (`x` must not be 0); a
+         * single `tzcnt`/`bsf` instruction.
+         *
+         * @param[in] x
+         * @return size_t
+         */
+        inline auto count_trailing_zeros(uint64_t x) -> size_t {
+#if defined(__GNUC__) || defined(__clang__)
+            return size_t(__builtin_ctzll(x));
+#elif defined(_MSC_VER)
+            unsigned long idx;
+            _BitScanForward64(&idx, x);
+            return size_t(idx);
+#else
+            auto n = size_t(0);
+            for (; (x & 1U) == 0; x >>= 1U) {
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        template <typename T> struct RobinMaskIterableWrapper;
+
+        /**
+         * @brief RobinMaskIterator
+         *
+         * The iterator of `Robin::exclude(mask, from_part)`. It holds the word of
+         * the mask it is in and the bits of that word that are still to be
+         * visited, so that stepping to the next part is a clear-lowest-bit and a
+         * bit scan. The `segment` is 0 for the parts after `from_part`, 1 for the
+         * parts before it, and 2 at the end.
+         *
+         * @tparam T
+         */
+        template <typename T> struct RobinMaskIterator {
+            const RobinMaskIterableWrapper<T> *wrapper;
+            size_t segment;
+            size_t word;
+            uint64_t bits;
+
+            /**
+             * @brief Not equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator!=(const RobinMaskIterator &other) const -> bool {
+                return segment != other.segment || word != other.word || bits != other.bits;
+            }
+
+            /**
+             * @brief Equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator==(const RobinMaskIterator &other) const -> bool {
+                return !(*this != other);
+            }
+
+            /**
+             * @brief
+             *
+             * @return RobinMaskIterator&
+             */
+            auto operator++() -> RobinMaskIterator & {
+                this->bits &= this->bits - 1;
+                wrapper->settle(*this);
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * @return T
+             */
+            auto operator*() const -> T { return T(this->part()); }
+
+            auto part() const -> size_t { return word * 64 + count_trailing_zeros(bits); }
+        };
+
+        /**
+         * @brief RobinMaskIterableWrapper
+         *
+         * The iterable returned by `Robin::exclude(mask, from_part)`. Instead of
+         * following the links part by part, it scans the complement of the mask a
+         * 64-bit word at a time, so runs of excluded parts cost one bit scan per
+         * word. Inactive parts are still looked up in the cycle, unless every
+         * part is active.
+         *
+         * @tparam T
+         */
+        template <typename T> struct RobinMaskIterableWrapper {
+            const uint64_t *mask;
+            size_t mask_words;
+            const RobinNode<T> *cycle;
+            size_t num_parts;
+            size_t from_part;
+            bool all_active;
+
+            /**
+             * @brief begin
+             *
+             * @return RobinMaskIterator<T>
+             */
+            auto begin() const -> RobinMaskIterator<T> {
+                auto it = RobinMaskIterator<T>{this, 0, 0, 0};
+                this->enter(it, 0);
+                this->settle(it);
+                return it;
+            }
+
+            /**
+             * @brief end
+             *
+             * @return RobinMaskIterator<T>
+             */
+            auto end() const -> RobinMaskIterator<T> { return RobinMaskIterator<T>{this, 2, 0, 0}; }
+
+            /**
+             * @brief settle
+             *
+             * Moves `it` forward until its lowest bit is an active part, loading
+             * the following words and segments as they run out.
+             *
+             * @param[in,out] it
+             */
+            void settle(RobinMaskIterator<T> &it) const {
+                for (;;) {
+                    while (it.bits == 0) {
+                        if (it.segment == 2) {
+                            return;
+                        }
+                        if (++it.word * 64 < this->hi(it.segment)) {
+                            it.bits = this->allowed(it.word, it.segment);
+                        } else {
+                            this->enter(it, it.segment + 1);
+                        }
+                    }
+                    if (this->all_active || cycle[it.part()].next != T(num_parts)) {
+                        return;
+                    }
+                    it.bits &= it.bits - 1;  // deactivated
+                }
+            }
+
+          private:
+            // segment 0 is [from_part + 1, num_parts), segment 1 is [0, from_part)
+            auto lo(size_t segment) const -> size_t { return segment == 0 ? from_part + 1 : 0; }
+            auto hi(size_t segment) const -> size_t { return segment == 0 ? num_parts : from_part; }
+
+            void enter(RobinMaskIterator<T> &it, size_t segment) const {
+                it.segment = segment;
+                if (segment == 2) {
+                    it.word = 0;
+                    it.bits = 0;
+                    return;
+                }
+                it.word = this->lo(segment) / 64;
+                it.bits = this->allowed(it.word, segment);
+            }
+
+            // the parts of word `w` that are in `segment` and not in the mask
+            auto allowed(size_t w, size_t segment) const -> uint64_t {
+                const auto lo = this->lo(segment);
+                const auto hi = this->hi(segment);
+                const auto base = w * 64;
+                if (hi <= base) {
+                    return 0;
+                }
+                auto bits = w < mask_words ? ~mask[w] : ~uint64_t(0);
+                if (lo > base) {
+                    bits &= ~uint64_t(0) << (lo - base);
+                }
+                if (hi - base < 64) {
+                    bits &= ~(~uint64_t(0) << (hi - base));
+                }
+                return bits;
+            }
+        };
+
+        /**
+         * @brief ArithRobinIterator
+         *
+         * The `ArithRobinIterator` struct walks the round-robin cycle of an
+         * `ArithRobin` without any nodes: the successor of part `cur` is `cur + 1`,
+         * wrapping around to 0 after the last part.
+         *
+         * @tparam T
+         */
+        template <typename T> struct ArithRobinIterator {
+            T cur;
+            T num_parts;
+
+            /**
+             * @brief Not equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator!=(const ArithRobinIterator &other) const -> bool {
+                return cur != other.cur;
+            }
+
+            /**
+             * @brief Equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator==(const ArithRobinIterator &other) const -> bool {
+                return cur == other.cur;
+            }
+
+            /**
+             * @brief
+             *
+             * Advances to the next part with a compare-and-wrap.
+             *
+             * @return ArithRobinIterator&
+             */
+            auto operator++() -> ArithRobinIterator & {
+                cur = T(cur + 1) == num_parts ? T(0) : T(cur + 1);
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * @return const T&
+             */
+            auto operator*() const -> const T & { return cur; }
+        };
+
+        /**
+         * @brief ArithRobinIterableWrapper
+         *
+         * The `ArithRobinIterableWrapper` struct is the iterable returned by
+         * `ArithRobin::exclude()`. It visits every part after `from_part` in cyclic
+         * order and stops when it comes back to `from_part`.
+         *
+         * @tparam T
+         */
+        template <typename T> struct ArithRobinIterableWrapper {
+            T from_part;
+            T num_parts;
+
+            /**
+             * @brief begin
+             *
+             * @return ArithRobinIterator<T>
+             */
+            auto begin() const -> ArithRobinIterator<T> {
+                return ++ArithRobinIterator<T>{from_part, num_parts};
+            }
+
+            /**
+             * @brief end
+             *
+             * @return ArithRobinIterator<T>
+             */
+            auto end() const -> ArithRobinIterator<T> {
+                return ArithRobinIterator<T>{from_part, num_parts};
+            }
+        };
+
+        /**
+         * @brief WeightedRobinSlot
+         *
+         * The next pick of one part in a weighted round: the `k`-th of the
+         * `weight` picks of `part` is due at the midpoint `(2k + 1) / (2 weight)`
+         * of its share of the round. `rank` is the position of the part in the
+         * cycle after the excluded part and breaks ties.
+         *
+         * @tparam T
+         */
+        template <typename T> struct WeightedRobinSlot {
+            uint64_t k;
+            uint64_t weight;
+            T part;
+            T rank;
+
+            /**
+             * @brief later
+             *
+             * Returns whether slot `a` is due after slot `b` (the ordering of the
+             * heap). The due times are compared exactly by cross-multiplying.
+             *
+             * @param[in] a
+             * @param[in] b
+             * @return true
+             * @return false
+             */
+            static auto later(const WeightedRobinSlot &a, const WeightedRobinSlot &b) -> bool {
+                const auto lhs = (2 * a.k + 1) * b.weight;
+                const auto rhs = (2 * b.k + 1) * a.weight;
+                return lhs != rhs ? lhs > rhs : a.rank > b.rank;
+            }
+        };
+
+        template <typename T> struct WeightedRobinIterableWrapper;
+
+        /**
+         * @brief WeightedRobinIterator
+         *
+         * The `WeightedRobinIterator` struct walks a weighted round. It is an input
+         * iterator: incrementing it consumes the next pick of the round held by
+         * the iterable.
+         *
+         * @tparam T
+         */
+        template <typename T> struct WeightedRobinIterator {
+            WeightedRobinIterableWrapper<T> *round;
+            size_t remaining;
+
+            /**
+             * @brief Not equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator!=(const WeightedRobinIterator &other) const -> bool {
+                return remaining != other.remaining;
+            }
+
+            /**
+             * @brief Equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator==(const WeightedRobinIterator &other) const -> bool {
+                return remaining == other.remaining;
+            }
+
+            /**
+             * @brief
+             *
+             * @return WeightedRobinIterator&
+             */
+            auto operator++() -> WeightedRobinIterator & {
+                round->pop();
+                --remaining;
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * Returns the part of the slot that is due next.
+             *
+             * @return const T&
+             */
+            auto operator*() const -> const T & { return round->heap.front().part; }
+        };
+
+        /**
+         * @brief WeightedRobinIterableWrapper
+         *
+         * The iterable returned by `WeightedRobin::exclude()`. It owns a heap with
+         * the next slot of every part, ordered by due time, so each step of the
+         * round costs O(log n).
+         *
+         * It is a single-pass range, which is why `begin()` and `end()` are not
+         * `const`: iterating consumes the round, one pick per increment. A second
+         * loop over the same object resumes at the pick where the first one
+         * stopped; once the round is complete, the object is empty. Call
+         * `exclude()` again for a new round.
+         *
+         * @tparam T
+         */
+        template <typename T> struct WeightedRobinIterableWrapper {
+            std::vector<WeightedRobinSlot<T>> heap;
+            size_t count;  // number of picks left in the round
+
+            /**
+             * @brief begin
+             *
+             * Returns an iterator to the next pick that has not been consumed.
+             *
+             * @return WeightedRobinIterator<T>
+             */
+            auto begin() -> WeightedRobinIterator<T> {
+                return WeightedRobinIterator<T>{this, count};
+            }
+
+            /**
+             * @brief end
+             *
+             * @return WeightedRobinIterator<T>
+             */
+            auto end() -> WeightedRobinIterator<T> { return WeightedRobinIterator<T>{this, 0}; }
+
+            /**
+             * @brief pop
+             *
+             * Consumes the slot that is due next and schedules the following pick
+             * of the same part, if it has one left in this round.
+             */
+            void pop() {
+                --count;
+                std::pop_heap(heap.begin(), heap.end(), WeightedRobinSlot<T>::later);
+                auto &slot = heap.back();
+                if (++slot.k == slot.weight) {
+                    heap.pop_back();
+                } else {
+                    std::push_heap(heap.begin(), heap.end(), WeightedRobinSlot<T>::later);
+                }
+            }
         };
     }  // namespace detail
 
@@ -143,42 +579,328 @@ namespace fun {
      * assigned a unique key. The `exclude` method returns an iterable wrapper that
      * excludes a specified part from the cycle.
      *
+     * Parts can be taken out of the cycle with `deactivate()` and put back with
+     * `reactivate()`; `exclude()` then only visits the active parts. A
+     * deactivated part is unlinked from its neighbours in O(1), in the manner of
+     * dancing links. The active parts always stay in cyclic order.
+     *
      * @tparam T
      */
     template <typename T> struct Robin {
-        std::vector<detail::RobinSlNode<T>> cycle;
+        std::vector<detail::RobinNode<T>> cycle;
+        T num_active;
 
         /**
          * @brief Construct a new Robin object
          *
          * The code is defining a constructor for the `Robin` class. The constructor
          * takes a parameter `num_parts` of type `T`, which represents the number of
-         * parts in the round-robin cycle.
+         * parts in the round-robin cycle. All parts are active initially.
          *
          * @param[in] num_parts
          */
-        explicit Robin(T num_parts) : cycle(num_parts) {
-            auto *slptr = &this->cycle[num_parts - 1];
+        explicit Robin(T num_parts) : cycle(num_parts), num_active(num_parts) {
+            auto prev = T(num_parts - 1);
             auto k = T(0);
             for (auto &sl : this->cycle) {
-                sl.key = k;
-                slptr->next = &sl;
-                slptr = slptr->next;
+                sl.prev = prev;
+                this->cycle[prev].next = k;
+                prev = k;
                 ++k;
             }
         }
 
+        /**
+         * @brief is_active
+         *
+         * @param[in] part
+         * @return true
+         * @return false
+         */
+        auto is_active(T part) const -> bool { return this->cycle[part].next != this->inactive(); }
+
+        /**
+         * @brief deactivate
+         *
+         * Takes `part` out of the cycle in O(1) by linking its neighbours to each
+         * other. Deactivating an inactive part has no effect.
+         *
+         * @param[in] part
+         */
+        void deactivate(T part) {
+            if (!this->is_active(part)) {
+                return;
+            }
+            auto &sl = this->cycle[part];
+            this->cycle[sl.prev].next = sl.next;
+            this->cycle[sl.next].prev = sl.prev;
+            sl.next = this->inactive();
+            --this->num_active;
+        }
+
+        /**
+         * @brief reactivate
+         *
+         * Puts `part` back into the cycle, in front of the next active part, so
+         * that the cycle stays in order. This is O(1) unless it has to skip over a
+         * run of inactive parts that follows `part`. Reactivating an active part
+         * has no effect.
+         *
+         * @param[in] part
+         */
+        void reactivate(T part) {
+            if (this->is_active(part)) {
+                return;
+            }
+            auto &sl = this->cycle[part];
+            if (this->num_active == 0) {
+                sl.next = sl.prev = part;
+            } else {
+                const auto succ = this->next_active(part);
+                sl.next = succ;
+                sl.prev = this->cycle[succ].prev;
+                this->cycle[sl.prev].next = part;
+                this->cycle[succ].prev = part;
+            }
+            ++this->num_active;
+        }
+
         /**
          * @brief exclude
          *
          * The `exclude` method in the `Robin` class returns an iterable wrapper
-         * that excludes a specified part from the cycle.
+         * that visits all active parts except `from_part`, in cyclic order starting
+         * after `from_part`. If `from_part` is inactive itself, all active parts
+         * are visited.
          *
          * @param[in] from_part
          * @return detail::RobinIterableWrapper<T>
          */
         auto exclude(T from_part) const -> detail::RobinIterableWrapper<T> {
-            return detail::RobinIterableWrapper<T>{&this->cycle[from_part]};
+            if (this->is_active(from_part)) {
+                return detail::RobinIterableWrapper<T>{
+                    this->cycle.data(), this->cycle[from_part].next, T(this->num_active - 1)};
+            }
+            const auto first = this->num_active == 0 ? from_part : this->next_active(from_part);
+            return detail::RobinIterableWrapper<T>{this->cycle.data(), first, this->num_active};
+        }
+
+        /**
+         * @brief exclude(mask, from_part)
+         *
+         * Returns an iterable wrapper that visits all active parts except
+         * `from_part` and the parts in `mask`, in cyclic order starting after
+         * `from_part`. Part `p` is excluded when bit `p % 64` of `mask[p / 64]`
+         * is set; missing words exclude nothing. The iteration jumps over the
+         * excluded parts with word-level bit scans. `mask` must outlive the
+         * iteration; a temporary mask is rejected at compile time.
+         *
+         * @param[in] mask
+         * @param[in] from_part
+         * @return detail::RobinMaskIterableWrapper<T>
+         */
+        auto exclude(const std::vector<uint64_t> &mask, T from_part) const
+            -> detail::RobinMaskIterableWrapper<T> {
+            const auto num_parts = this->cycle.size();
+            return detail::RobinMaskIterableWrapper<T>{mask.data(),        mask.size(),
+                                                       this->cycle.data(), num_parts,
+                                                       size_t(from_part),
+                                                       this->num_active == num_parts};
+        }
+
+        /**
+         * @brief exclude(mask, from_part) with a temporary mask
+         *
+         * Deleted: the wrapper refers to the words of `mask`, which would be
+         * destroyed before the loop runs.
+         */
+        auto exclude(std::vector<uint64_t> &&mask, T from_part) const
+            -> detail::RobinMaskIterableWrapper<T> = delete;
+
+      private:
+        // the `next` link of an inactive part; it is never a valid part
+        auto inactive() const -> T { return T(this->cycle.size()); }
+
+        // the first active part after `part` (there must be one)
+        auto next_active(T part) const -> T {
+            const auto num_parts = this->cycle.size();
+            auto k = size_t(part);
+            do {
+                k = k + 1 == num_parts ? 0 : k + 1;
+            } while (!this->is_active(T(k)));
+            return T(k);
+        }
+    };
+
+    /**
+     * @brief Round Robin without nodes
+     *
+     * The `ArithRobin` class visits the parts in the same order as `Robin`, but
+     * it does not allocate a linked cycle: it only stores the number of parts and
+     * computes the next part arithmetically. It takes `sizeof(T)` bytes instead
+     * of one node per part, and `exclude()` iterates without pointer chasing,
+     * which matters when many of them are alive at once (e.g. one per worker).
+     *
+     * @tparam T
+     */
+    template <typename T> struct ArithRobin {
+        T num_parts;
+
+        /**
+         * @brief Construct a new ArithRobin object
+         *
+         * @param[in] num_parts
+         */
+        explicit ArithRobin(T num_parts) : num_parts(num_parts) {}
+
+        /**
+         * @brief exclude
+         *
+         * The `exclude` method returns an iterable wrapper that visits all parts
+         * except `from_part`, starting with the one after it.
+         *
+         * @param[in] from_part
+         * @return detail::ArithRobinIterableWrapper<T>
+         */
+        auto exclude(T from_part) const -> detail::ArithRobinIterableWrapper<T> {
+            return detail::ArithRobinIterableWrapper<T>{from_part, this->num_parts};
+        }
+    };
+
+    /**
+     * @brief Round Robin for concurrent callers
+     *
+     * The `ConcurrentRobin` class hands out parts in round-robin order to many
+     * threads at once. It has no lock: every call takes a ticket from a shared
+     * atomic cursor with a single `fetch_add` and maps the ticket to a part, so
+     * any `num_parts` consecutive tickets of `next()` cover every part exactly
+     * once, no matter how the calls of the threads interleave. The cursor has a
+     * cache line to itself so that it does not falsely share with neighbouring
+     * data.
+     *
+     * @tparam T
+     */
+    template <typename T> struct alignas(64) ConcurrentRobin {
+        T num_parts;
+        alignas(64) std::atomic<size_t> cursor;
+
+        /**
+         * @brief Construct a new ConcurrentRobin object
+         *
+         * @param[in] num_parts
+         */
+        explicit ConcurrentRobin(T num_parts) : num_parts(num_parts), cursor(0) {}
+
+        /**
+         * @brief next
+         *
+         * Returns the next part of the cycle.
+         *
+         * @return T
+         */
+        auto next() -> T {
+            return T(this->cursor.fetch_add(1, std::memory_order_relaxed) % this->num_parts);
+        }
+
+        /**
+         * @brief next_excluding
+         *
+         * Returns the next part of the cycle other than `self` (there must be at
+         * least two parts). The tickets are mapped onto the other `num_parts - 1`
+         * parts, so any `num_parts - 1` consecutive tickets taken with the same
+         * `self` cover every other part exactly once.
+         *
+         * @param[in] self
+         * @return T
+         */
+        auto next_excluding(T self) -> T {
+            const auto k = this->cursor.fetch_add(1, std::memory_order_relaxed)
+                           % size_t(this->num_parts - 1);
+            return T(k < size_t(self) ? k : k + 1);
+        }
+    };
+
+    /**
+     * @brief Smooth weighted Round Robin
+     *
+     * The `WeightedRobin` class visits each part as many times per round as its
+     * weight, so that parts with a larger capacity get a proportionally larger
+     * share. The picks of a heavy part are spread evenly over the round instead
+     * of coming in a burst, by due times: the `k`-th of the `w` picks of a part
+     * is due at `(2k + 1) / (2w)` of the round, the midpoint of its share. A
+     * binary heap of the next due pick of every part yields the picks in order
+     * of their due times, ties going to the part that comes first in the cycle.
+     * The sequence is as smooth as that of nginx's weighted round robin, but it
+     * is not the same sequence. With equal weights a round is exactly the cycle
+     * of `Robin`.
+     *
+     * Setting a weight is O(1), since the weights are only read when a round
+     * starts; each step of a round costs O(log n). A part with weight 0 is not
+     * visited at all. Weights must be below `max_weight` (2^31), so that the due
+     * times compare exactly in 64 bits; debug builds assert it.
+     *
+     * @tparam T
+     */
+    template <typename T> struct WeightedRobin {
+        static constexpr size_t max_weight = size_t(1) << 31;
+
+        std::vector<size_t> weights;
+
+        /**
+         * @brief Construct a new WeightedRobin object
+         *
+         * All parts start with weight 1.
+         *
+         * @param[in] num_parts
+         */
+        explicit WeightedRobin(T num_parts) : weights(num_parts, 1) {}
+
+        /**
+         * @brief Construct a new WeightedRobin object
+         *
+         * @param[in] weights the weight of each part
+         */
+        explicit WeightedRobin(std::vector<size_t> weights) : weights(std::move(weights)) {}
+
+        /**
+         * @brief set_weight
+         *
+         * @param[in] part
+         * @param[in] weight
+         */
+        void set_weight(T part, size_t weight) {
+            assert(weight < max_weight);
+            this->weights[part] = weight;
+        }
+
+        /**
+         * @brief exclude
+         *
+         * Returns a single-pass iterable over one weighted round of all parts
+         * except `from_part`. Each other part is visited as many times as its
+         * weight; among picks that are due at the same time, the parts after
+         * `from_part` in the cycle come first.
+         *
+         * @param[in] from_part
+         * @return detail::WeightedRobinIterableWrapper<T>
+         */
+        auto exclude(T from_part) const -> detail::WeightedRobinIterableWrapper<T> {
+            const auto num_parts = this->weights.size();
+            auto round = detail::WeightedRobinIterableWrapper<T>{{}, 0};
+            round.heap.reserve(num_parts);
+            auto part = size_t(from_part);
+            for (size_t rank = 0; rank + 1 < num_parts; ++rank) {
+                part = part + 1 == num_parts ? 0 : part + 1;
+                const auto weight = this->weights[part];
+                assert(weight < max_weight);
+                if (weight != 0) {
+                    round.heap.push_back({0, weight, T(part), T(rank)});
+                    round.count += weight;
+                }
+            }
+            std::make_heap(round.heap.begin(), round.heap.end(),
+                           detail::WeightedRobinSlot<T>::later);
+            return round;
         }
     };
 
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>             // import std::array
+#include <cstddef>           // import size_t
+#include <initializer_list>  // import std::initializer_list
+#include <type_traits>       // import std::integral_constant
+#include <utility>           // import std::index_sequence
+
+#include "enumerate.hpp"
+#include "range.hpp"
+
+namespace py {
+
+    namespace detail {
+
+        // Python's len(range(begin, end, step))
+        constexpr auto static_range_size(std::ptrdiff_t begin, std::ptrdiff_t end,
+                                         std::ptrdiff_t step) -> size_t {
+            return step > 0 ? (end > begin ? size_t((end - begin + step - 1) / step) : 0)
+                            : (begin > end ? size_t((begin - end - step - 1) / -step) : 0);
+        }
+
+        template <std::ptrdiff_t Begin, std::ptrdiff_t Step, typename Body, size_t... K>
+        CONSTEXPR14 void static_for(Body &body, std::index_sequence<K...> /* unused */) {
+            static_cast<void>(body);  // unused if the range is empty
+            (void)std::initializer_list<int>{
+                (static_cast<void>(body(
+                     std::integral_constant<std::ptrdiff_t,
+                                            Begin + static_cast<std::ptrdiff_t>(K) * Step>{})),
+                 0)...};
+        }
+
+        template <typename Wrapper, typename Body, size_t... K>
+        void static_for_enumerate(Wrapper &wrapper, Body &body,
+                                  std::index_sequence<K...> /* unused */) {
+            static_cast<void>(body);
+            const auto first = wrapper.begin();
+            (void)std::initializer_list<int>{(static_cast<void>(body(first[K])), 0)...};
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief static_range<Begin, End, Step>
+     *
+     * The `static_range` struct is the compile-time counterpart of
+     * `range(Begin, End, Step)`. Its length is a constant expression, so that
+     * `static_for()` can expand it with `std::make_index_sequence` and hand each
+     * value to the loop body as an `std::integral_constant`. At run time it
+     * converts to the equivalent `StepRange`.
+     *
+     * @tparam Begin
+     * @tparam End
+     * @tparam Step
+     */
+    template <std::ptrdiff_t Begin, std::ptrdiff_t End, std::ptrdiff_t Step = 1>
+    struct static_range {
+        static_assert(Step != 0, "static_range() arg 3 must not be zero");
+
+        using value_type = std::ptrdiff_t;
+
+        static constexpr size_t length = detail::static_range_size(Begin, End, Step);
+
+        /**
+         * @brief size
+         *
+         * @return size_t
+         */
+        static constexpr auto size() -> size_t { return length; }
+
+        /**
+         * @brief empty
+         *
+         * @return true
+         * @return false
+         */
+        static constexpr auto empty() -> bool { return length == 0; }
+
+        /**
+         * @brief operator[]
+         *
+         * @param[in] n
+         * @return std::ptrdiff_t
+         */
+        constexpr auto operator[](size_t n) const -> std::ptrdiff_t {
+            return Begin + static_cast<std::ptrdiff_t>(n) * Step;
+        }  // no bounds checking
+
+        /**
+         * @brief StepRange
+         *
+         * The same values, as a run-time range.
+         *
+         * @return StepRange<std::ptrdiff_t>
+         */
+        CONSTEXPR14 operator StepRange<std::ptrdiff_t>() const {
+            return range(Begin, Begin + static_cast<std::ptrdiff_t>(length) * Step, Step);
+        }
+    };
+
+    /**
+     * @brief static_for<Begin, End, Step>(body)
+     *
+     * The `static_for` function calls `body(i)` for the values `i` of
+     * `range(Begin, End, Step)`, where `i` is an
+     * `std::integral_constant<std::ptrdiff_t, value>`. The loop is fully
+     * unrolled, and `i` can be used as a template argument, e.g.
+     * `std::get<i>(tuple)`, or in `if constexpr`. It converts implicitly to its
+     * value everywhere else.
+     *
+     * @tparam Begin
+     * @tparam End
+     * @tparam Step
+     * @tparam Body
+     * @param[in] body
+     */
+    template <std::ptrdiff_t Begin, std::ptrdiff_t End, std::ptrdiff_t Step = 1, typename Body>
+    CONSTEXPR14 void static_for(Body &&body) {
+        detail::static_for<Begin, Step>(
+            body, std::make_index_sequence<static_range<Begin, End, Step>::length>{});
+    }
+
+    /**
+     * @brief static_for<End>(body)
+     *
+     * Same as `static_for<0, End>(body)`.
+     *
+     * @tparam End
+     * @tparam Body
+     * @param[in] body
+     */
+    template <std::ptrdiff_t End, typename Body> CONSTEXPR14 void static_for(Body &&body) {
+        static_for<0, End, 1>(body);
+    }
+
+    /**
+     * @brief static_for(static_range<Begin, End, Step>{}, body)
+     *
+     * Same as `static_for<Begin, End, Step>(body)`.
+     *
+     * @tparam Begin
+     * @tparam End
+     * @tparam Step
+     * @tparam Body
+     * @param[in] rng unused
+     * @param[in] body
+     */
+    template <std::ptrdiff_t Begin, std::ptrdiff_t End, std::ptrdiff_t Step, typename Body>
+    CONSTEXPR14 void static_for(static_range<Begin, End, Step> rng, Body &&body) {
+        static_cast<void>(rng);
+        static_for<Begin, End, Step>(body);
+    }
+
+    /**
+     * @brief static_for(enumerate(array), body)
+     *
+     * Unrolls `for (auto p : enumerate(array)) body(p);` over an `std::array`,
+     * whose size is a compile-time constant. `body` receives the same pairs of
+     * an index (offset by the start of `enumerate()`) and a reference to the
+     * element as in the run-time loop, so the same body can be used in both.
+     *
+     * @tparam T
+     * @tparam N
+     * @tparam Index
+     * @tparam Body
+     * @param[in] wrapper
+     * @param[in] body
+     */
+    template <typename T, size_t N, typename Index, typename Body>
+    void static_for(detail::EnumerateIterableWrapper<std::array<T, N> &, Index> wrapper,
+                    Body &&body) {
+        detail::static_for_enumerate(wrapper, body, std::make_index_sequence<N>{});
+    }
+
+    /**
+     * @brief static_for(enumerate(array), body)
+     *
+     * Same as above, over a `const std::array`.
+     *
+     * @tparam T
+     * @tparam N
+     * @tparam Index
+     * @tparam Body
+     * @param[in] wrapper
+     * @param[in] body
+     */
+    template <typename T, size_t N, typename Index, typename Body>
+    void static_for(detail::EnumerateIterableWrapper<const std::array<T, N> &, Index> wrapper,
+                    Body &&body) {
+        detail::static_for_enumerate(wrapper, body, std::make_index_sequence<N>{});
+    }
+
+}  // namespace py
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <algorithm>    // import std::sort, std::min
+#include <array>        // import std::array
+#include <chrono>       // import std::chrono::steady_clock
+#include <cstddef>      // import size_t
+#include <cstdint>      // import uint64_t
+#include <ios>          // import std::fixed
+#include <iterator>     // import std::begin, std::end
+#include <memory>       // import std::shared_ptr
+#include <mutex>        // import std::mutex, std::lock_guard
+#include <ostream>      // import std::ostream
+#include <string>       // import std::string
+#include <type_traits>  // import std::remove_reference
+#include <utility>      // import std::forward
+#include <vector>       // import std::vector
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <intrin.h>  // import __rdtsc
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    include <x86intrin.h>  // import __rdtsc
+#endif
+
+/**
+ * @brief PYRANGE_TRACE
+ *
+ * Compile-time switch of the loop instrumentation. With `PYRANGE_TRACE` 0 (the
+ * default), `PYRANGE_TRACED(rng)` expands to `(rng)` and the loop compiles to
+ * exactly the same code as without the marker. Define it to 1 before including
+ * this header, or with `-DPYRANGE_TRACE=1`, to record the loops.
+ */
+#ifndef PYRANGE_TRACE
+#    define PYRANGE_TRACE 0
+#endif
+
+/**
+ * @brief PYRANGE_TRACED(rng)
+ *
+ * Marks a hot loop for the instrumentation:
+ *
+ *     for (auto i : PYRANGE_TRACED(py::range(n))) { ... }
+ *     for (auto k : PYRANGE_TRACED(robin.exclude(part))) { ... }
+ *
+ * Each marker is a call site of its own. When `PYRANGE_TRACE` is on, every run
+ * of the loop records its trip count and its duration in time-stamp-counter
+ * ticks into a buffer of the running thread; see `trace_stats()`,
+ * `write_trace_summary()` and `write_chrome_trace()`. `rng` may be any range,
+ * e.g. `range()`, `enumerate()` or `Robin::exclude()`; the marker only wraps it
+ * for a range-based for loop.
+ */
+#if PYRANGE_TRACE
+#    define PYRANGE_TRACED(...)                                                         \
+        ::py::detail::traced(__VA_ARGS__, [] {                                          \
+            static const ::py::TraceSite site{#__VA_ARGS__, __FILE__, __LINE__};        \
+            return &site;                                                               \
+        }())
+#else
+#    define PYRANGE_TRACED(...) (__VA_ARGS__)
+#endif
+
+namespace py {
+
+    /**
+     * @brief TraceSite
+     *
+     * A loop marked with `PYRANGE_TRACED`: the marked expression and where it is.
+     */
+    struct TraceSite {
+        const char *expr;
+        const char *file;
+        int line;
+    };
+
+    /**
+     * @brief TraceStats
+     *
+     * What the instrumentation recorded for one call site: the number of runs
+     * of the loop, the total number of iterations, the total time in ticks of
+     * `trace_clock()`, and a histogram of the trip counts, where `trips[b]`
+     * counts the runs with a trip count in `[2^(b-1), 2^b)` (`trips[0]` counts
+     * the empty runs).
+     */
+    struct TraceStats {
+        const TraceSite *site;
+        size_t calls;
+        size_t iterations;
+        uint64_t ticks;
+        std::array<size_t, 65> trips;
+    };
+
+    /**
+     * @brief trace_clock
+     *
+     * The time stamp counter where the CPU has one (x86), `steady_clock`
+     * otherwise. Reading it costs a few nanoseconds.
+     *
+     * @return uint64_t
+     */
+    inline auto trace_clock() -> uint64_t {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    namespace detail {
+
+        struct TraceEvent {
+            const TraceSite *site;
+            uint64_t start;
+            uint64_t stop;
+            size_t trips;
+        };
+
+        // the events of one thread; the mutex is only contended while exporting
+        struct TraceBuffer {
+            std::mutex mutex;
+            std::vector<TraceEvent> events;
+            size_t tid;
+        };
+
+        /**
+         * @brief TraceRegistry
+         *
+         * Owns the buffers of all threads that have recorded a loop. A buffer
+         * outlives its thread, so that the loops of joined workers can still be
+         * exported. The clock is calibrated against `steady_clock` from the end
+         * of the first recorded loop on, to convert ticks to microseconds.
+         */
+        struct TraceRegistry {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<TraceBuffer>> buffers;
+            uint64_t tick0 = trace_clock();
+            std::chrono::steady_clock::time_point time0 = std::chrono::steady_clock::now();
+
+            static auto instance() -> TraceRegistry & {
+                static TraceRegistry registry;
+                return registry;
+            }
+
+            auto add() -> std::shared_ptr<TraceBuffer> {
+                auto buffer = std::make_shared<TraceBuffer>();
+                std::lock_guard<std::mutex> lock(this->mutex);
+                buffer->tid = this->buffers.size();
+                this->buffers.push_back(buffer);
+                return buffer;
+            }
+
+            auto ticks_per_us() -> double {
+                const auto ticks = trace_clock() - this->tick0;
+                const auto us = std::chrono::duration<double, std::micro>(
+                                    std::chrono::steady_clock::now() - this->time0)
+                                    .count();
+                return us > 0.0 && ticks > 0 ? double(ticks) / us : 1.0;
+            }
+        };
+
+        inline auto trace_buffer() -> TraceBuffer & {
+            thread_local const auto buffer = TraceRegistry::instance().add();
+            return *buffer;
+        }
+
+        /**
+         * @brief TracedIterator
+         *
+         * Forwards to the iterator of the marked range and counts the
+         * increments.
+         *
+         * @tparam Iter
+         */
+        template <typename Iter> struct TracedIterator {
+            Iter it;
+            size_t *count;
+
+            auto operator*() const -> decltype(*it) { return *this->it; }
+
+            auto operator++() -> TracedIterator & {
+                ++this->it;
+                ++*this->count;
+                return *this;
+            }
+
+            template <typename Sent> auto operator!=(const TracedIterator<Sent> &other) const
+                -> bool {
+                return this->it != other.it;
+            }
+
+            template <typename Sent> auto operator==(const TracedIterator<Sent> &other) const
+                -> bool {
+                return this->it == other.it;
+            }
+        };
+
+        /**
+         * @brief TracedRange
+         *
+         * What `PYRANGE_TRACED(rng)` yields when the switch is on. A range-based
+         * for loop keeps it alive until the loop ends, so the destructor sees
+         * the loop finish, also through `break` or an exception, and records it.
+         *
+         * @tparam T the marked range, a reference if it is an lvalue
+         */
+        template <typename T> struct TracedRange {
+            using range_type = typename std::remove_reference<T>::type;
+
+            T rng;
+            const TraceSite *site;
+            size_t count = 0;
+            uint64_t start = 0;
+            bool running = false;
+
+            TracedRange(T &&rng, const TraceSite *site)
+                : rng(std::forward<T>(rng)), site(site) {}
+
+            TracedRange(TracedRange &&other) noexcept
+                : rng(std::forward<T>(other.rng)), site(other.site) {}
+
+            TracedRange(const TracedRange &) = delete;
+            auto operator=(const TracedRange &) -> TracedRange & = delete;
+            auto operator=(TracedRange &&) -> TracedRange & = delete;
+
+            ~TracedRange() {
+                if (this->running) {
+                    const auto stop = trace_clock();
+                    auto &buffer = trace_buffer();
+                    std::lock_guard<std::mutex> lock(buffer.mutex);
+                    buffer.events.push_back(TraceEvent{this->site, this->start, stop, this->count});
+                }
+            }
+
+            auto begin() -> TracedIterator<decltype(std::begin(std::declval<range_type &>()))> {
+                this->running = true;
+                this->count = 0;
+                this->start = trace_clock();
+                return {std::begin(this->rng), &this->count};
+            }
+
+            auto end() -> TracedIterator<decltype(std::end(std::declval<range_type &>()))> {
+                return {std::end(this->rng), &this->count};
+            }
+        };
+
+        template <typename T>
+        inline auto traced(T &&rng, const TraceSite *site) -> TracedRange<T> {
+            return TracedRange<T>(std::forward<T>(rng), site);
+        }
+
+        inline auto trace_bucket(size_t trips) -> size_t {
+            auto bucket = size_t(0);
+            for (; trips != 0; trips >>= 1U) {
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        inline void write_json_string(std::ostream &out, const char *s) {
+            out << '"';
+            for (; *s != '\0'; ++s) {
+                if (*s == '"' || *s == '\\') {
+                    out << '\\';
+                }
+                out << (*s == '\n' ? ' ' : *s);
+            }
+            out << '"';
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief trace_stats
+     *
+     * Aggregates the loops recorded so far by all threads, one entry per call
+     * site in the order in which the sites were first seen.
+     *
+     * @return std::vector<TraceStats>
+     */
+    inline auto trace_stats() -> std::vector<TraceStats> {
+        auto &registry = detail::TraceRegistry::instance();
+        auto stats = std::vector<TraceStats>{};
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto &buffer : registry.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            for (const auto &event : buffer->events) {
+                auto it = stats.begin();
+                while (it != stats.end() && it->site != event.site) {
+                    ++it;
+                }
+                if (it == stats.end()) {
+                    stats.push_back(TraceStats{event.site, 0, 0, 0, {}});
+                    it = stats.end() - 1;
+                }
+                ++it->calls;
+                it->iterations += event.trips;
+                it->ticks += event.stop - event.start;
+                ++it->trips[detail::trace_bucket(event.trips)];
+            }
+        }
+        return stats;
+    }
+
+    /**
+     * @brief trace_reset
+     *
+     * Drops everything recorded so far.
+     */
+    inline void trace_reset() {
+        auto &registry = detail::TraceRegistry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto &buffer : registry.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            buffer->events.clear();
+        }
+    }
+
+    /**
+     * @brief write_trace_summary
+     *
+     * Writes one line per call site, the busiest first: the site, the number
+     * of runs, iterations and ticks, the ticks per iteration and the nonempty
+     * buckets of the trip count histogram, e.g. `[8,16):120`.
+     *
+     * @param[in] out
+     */
+    inline void write_trace_summary(std::ostream &out) {
+        auto stats = trace_stats();
+        std::sort(stats.begin(), stats.end(), [](const TraceStats &a, const TraceStats &b) {
+            return a.ticks > b.ticks;
+        });
+        out << "site\tcalls\titerations\tticks\tticks/iteration\ttrips\n";
+        for (const auto &s : stats) {
+            out << s.site->file << ':' << s.site->line << ' ' << s.site->expr << '\t' << s.calls
+                << '\t' << s.iterations << '\t' << s.ticks << '\t'
+                << (s.iterations == 0 ? 0.0 : double(s.ticks) / double(s.iterations)) << '\t';
+            auto first = true;
+            for (auto b = size_t(0); b < s.trips.size(); ++b) {
+                if (s.trips[b] == 0) {
+                    continue;
+                }
+                out << (first ? "" : " ");
+                first = false;
+                if (b == 0) {
+                    out << "0:";
+                } else {
+                    out << '[' << (uint64_t(1) << (b - 1)) << ',';
+                    if (b < 64) {
+                        out << (uint64_t(1) << b);
+                    } else {
+                        out << "inf";
+                    }
+                    out << "):";
+                }
+                out << s.trips[b];
+            }
+            out << '\n';
+        }
+    }
+
+    /**
+     * @brief write_chrome_trace
+     *
+     * Writes every recorded run of a loop as a complete event (`"ph": "X"`) of
+     * the Chrome trace event format, with the trip count as an argument and
+     * one track per thread. Load the file in `chrome://tracing` or Perfetto.
+     *
+     * @param[in] out
+     */
+    inline void write_chrome_trace(std::ostream &out) {
+        auto &registry = detail::TraceRegistry::instance();
+        const auto ticks_per_us = registry.ticks_per_us();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto origin = registry.tick0;  // the earliest start, so that no time stamp is negative
+        for (const auto &buffer : registry.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            for (const auto &event : buffer->events) {
+                origin = std::min(origin, event.start);
+            }
+        }
+        const auto flags = out.flags();
+        const auto precision = out.precision(3);
+        out << std::fixed << "{\"traceEvents\":[";
+        auto first = true;
+        for (const auto &buffer : registry.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            for (const auto &event : buffer->events) {
+                out << (first ? "\n" : ",\n") << "{\"name\":";
+                first = false;
+                detail::write_json_string(out, event.site->expr);
+                out << ",\"cat\":\"loop\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->tid
+                    << ",\"ts\":" << double(event.start - origin) / ticks_per_us
+                    << ",\"dur\":" << double(event.stop - event.start) / ticks_per_us
+                    << ",\"args\":{\"trips\":" << event.trips << ",\"site\":";
+                detail::write_json_string(
+                    out, (std::string(event.site->file) + ':' + std::to_string(event.site->line))
+                             .c_str());
+                out << "}}";
+            }
+        }
+        out << "\n]}\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+}  // namespace py
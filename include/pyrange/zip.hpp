@@ -0,0 +1,512 @@
+#pragma once
+
+#include <algorithm>    // import std::min
+#include <cstddef>      // import size_t
+#include <functional>   // import std::reference_wrapper
+#include <iterator>     // import std::begin() std::end()
+#include <tuple>        // import std::tuple
+#include <type_traits>  // import std::common_type
+#include <utility>      // import std::index_sequence
+
+namespace py {
+
+    namespace detail {
+
+        template <bool... Bs> struct bool_pack {};
+
+        template <bool... Bs>
+        using all_true = std::is_same<bool_pack<true, Bs...>, bool_pack<Bs..., true>>;
+
+        template <typename C> using zip_iterator_t = decltype(std::begin(std::declval<C &>()));
+        template <typename C> using zip_sentinel_t = decltype(std::end(std::declval<C &>()));
+
+        template <typename Iter> using is_random_access = std::is_base_of<
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iter>::iterator_category>;
+
+        // an iterable with `data()` and `size()`, whose elements are contiguous
+        template <typename C, typename = void> struct is_contiguous : std::false_type {};
+
+        template <typename C>
+        struct is_contiguous<C, decltype(std::declval<C &>().data() + std::declval<C &>().size(),
+                                         void())> : std::true_type {};
+
+        /**
+         * @brief ZipIterator
+         *
+         * The `ZipIterator` struct walks several iterators in lockstep. Its
+         * category is the weakest category of the underlying iterators, so it is
+         * a random-access iterator when all of them are. Dereferencing it yields a
+         * tuple of the references of the underlying iterators; no element is
+         * copied. Because the iterators move together, two `ZipIterator`s of the
+         * same zip are compared by their first iterator only.
+         *
+         * @tparam Iters
+         */
+        template <typename... Iters> struct ZipIterator {
+            using iterator_category = typename std::common_type<
+                typename std::iterator_traits<Iters>::iterator_category...>::type;
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::tuple<typename std::iterator_traits<Iters>::value_type...>;
+            using reference = std::tuple<decltype(*std::declval<const Iters &>())...>;
+            using pointer = void;
+
+            std::tuple<Iters...> iters;
+
+            /**
+             * @brief Not equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator!=(const ZipIterator &other) const -> bool {
+                return std::get<0>(iters) != std::get<0>(other.iters);
+            }
+
+            /**
+             * @brief Equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator==(const ZipIterator &other) const -> bool {
+                return std::get<0>(iters) == std::get<0>(other.iters);
+            }
+
+            /**
+             * @brief
+             *
+             * Advances all the underlying iterators.
+             *
+             * @return ZipIterator&
+             */
+            auto operator++() -> ZipIterator & {
+                this->advance(1, std::index_sequence_for<Iters...>{});
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * @return ZipIterator
+             */
+            auto operator++(int) -> ZipIterator {
+                auto temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            /**
+             * @brief
+             *
+             * @return ZipIterator&
+             */
+            auto operator--() -> ZipIterator & {
+                this->advance(-1, std::index_sequence_for<Iters...>{});
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * @return ZipIterator
+             */
+            auto operator--(int) -> ZipIterator {
+                auto temp = *this;
+                --(*this);
+                return temp;
+            }
+
+            /**
+             * @brief
+             *
+             * Returns the tuple of references to the current elements.
+             *
+             * @return reference
+             */
+            auto operator*() const -> reference {
+                return this->deref(std::index_sequence_for<Iters...>{});
+            }
+
+            /**
+             * @brief
+             *
+             * The following operators are only available when all the underlying
+             * iterators are random-access iterators.
+             *
+             * @param[in] n
+             * @return ZipIterator&
+             */
+            auto operator+=(difference_type n) -> ZipIterator & {
+                this->advance(n, std::index_sequence_for<Iters...>{});
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * @param[in] n
+             * @return ZipIterator&
+             */
+            auto operator-=(difference_type n) -> ZipIterator & {
+                this->advance(-n, std::index_sequence_for<Iters...>{});
+                return *this;
+            }
+
+            /**
+             * @brief
+             *
+             * @param[in] n
+             * @return ZipIterator
+             */
+            auto operator+(difference_type n) const -> ZipIterator {
+                auto temp = *this;
+                return temp += n;
+            }
+
+            /**
+             * @brief
+             *
+             * @param[in] n
+             * @param[in] it
+             * @return ZipIterator
+             */
+            friend auto operator+(difference_type n, const ZipIterator &it) -> ZipIterator {
+                return it + n;
+            }
+
+            /**
+             * @brief
+             *
+             * @param[in] n
+             * @return ZipIterator
+             */
+            auto operator-(difference_type n) const -> ZipIterator {
+                auto temp = *this;
+                return temp -= n;
+            }
+
+            /**
+             * @brief
+             *
+             * Returns the number of elements between `other` and the current
+             * iterator.
+             *
+             * @param[in] other
+             * @return difference_type
+             */
+            auto operator-(const ZipIterator &other) const -> difference_type {
+                return static_cast<difference_type>(std::get<0>(iters) - std::get<0>(other.iters));
+            }
+
+            /**
+             * @brief
+             *
+             * @param[in] n
+             * @return reference
+             */
+            auto operator[](difference_type n) const -> reference { return *(*this + n); }
+
+            /**
+             * @brief Less than
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator<(const ZipIterator &other) const -> bool {
+                return std::get<0>(iters) < std::get<0>(other.iters);
+            }
+
+            /**
+             * @brief Greater than
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator>(const ZipIterator &other) const -> bool { return other < *this; }
+
+            /**
+             * @brief Less than or equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator<=(const ZipIterator &other) const -> bool { return !(other < *this); }
+
+            /**
+             * @brief Greater than or equal to
+             *
+             * @param[in] other
+             * @return true
+             * @return false
+             */
+            auto operator>=(const ZipIterator &other) const -> bool { return !(*this < other); }
+
+          private:
+            template <size_t... I>
+            void advance(difference_type n, std::index_sequence<I...> /* unused */) {
+                (void)std::initializer_list<int>{(std::advance(std::get<I>(iters), n), 0)...};
+            }
+
+            template <size_t... I>
+            auto deref(std::index_sequence<I...> /* unused */) const -> reference {
+                return reference{*std::get<I>(iters)...};
+            }
+        };
+
+        /**
+         * @brief ZipSentinel
+         *
+         * The end of a zip whose inputs are not all random access, or whose
+         * `end()` is a sentinel. A `ZipIterator` reaches it as soon as any of its
+         * iterators reaches the end of its input, so the zip stops at the
+         * shortest input.
+         *
+         * @tparam Sents
+         */
+        template <typename... Sents> struct ZipSentinel {
+            std::tuple<Sents...> ends;
+
+            template <typename... Iters>
+            friend auto operator==(const ZipIterator<Iters...> &it, const ZipSentinel &s) -> bool {
+                return s.reached(it, std::index_sequence_for<Sents...>{});
+            }
+
+            template <typename... Iters>
+            friend auto operator==(const ZipSentinel &s, const ZipIterator<Iters...> &it) -> bool {
+                return s.reached(it, std::index_sequence_for<Sents...>{});
+            }
+
+            template <typename... Iters>
+            friend auto operator!=(const ZipIterator<Iters...> &it, const ZipSentinel &s) -> bool {
+                return !s.reached(it, std::index_sequence_for<Sents...>{});
+            }
+
+            template <typename... Iters>
+            friend auto operator!=(const ZipSentinel &s, const ZipIterator<Iters...> &it) -> bool {
+                return !s.reached(it, std::index_sequence_for<Sents...>{});
+            }
+
+          private:
+            template <typename... Iters, size_t... I>
+            auto reached(const ZipIterator<Iters...> &it,
+                         std::index_sequence<I...> /* unused */) const -> bool {
+                auto any = false;
+                (void)std::initializer_list<int>{
+                    (any = any || std::get<I>(it.iters) == std::get<I>(ends), 0)...};
+                return any;
+            }
+        };
+
+        template <typename T>
+        using zip_storage_t = typename std::conditional<
+            std::is_lvalue_reference<T>::value,
+            std::reference_wrapper<typename std::remove_reference<T>::type>, T>::type;
+
+        template <typename T>
+        using zip_const_t = typename std::conditional<
+            std::is_lvalue_reference<T>::value, typename std::remove_reference<T>::type,
+            const typename std::remove_reference<T>::type>::type;
+
+        template <typename T> auto zip_unwrap(std::reference_wrapper<T> ref) -> T & {
+            return ref.get();
+        }
+
+        template <typename T> auto zip_unwrap(T &iterable) -> T & { return iterable; }
+
+        /**
+         * @brief ZipIterableWrapper
+         *
+         * The iterable returned by `zip()`. Like `EnumerateIterableWrapper`, it
+         * refers to lvalue inputs and owns rvalue inputs. Its end is a
+         * `ZipIterator` when all inputs are random-access common ranges, placed at
+         * the length of the shortest input, and a `ZipSentinel` otherwise.
+         *
+         * @tparam Ts
+         */
+        template <typename... Ts> struct ZipIterableWrapper {
+            using iterator
+                = ZipIterator<zip_iterator_t<typename std::remove_reference<Ts>::type>...>;
+            using const_iterator = ZipIterator<zip_iterator_t<zip_const_t<Ts>>...>;
+
+            // random-access common ranges, whose end can be computed in O(1)
+            template <bool Const> using is_sized = all_true<(
+                is_random_access<zip_iterator_t<typename std::conditional<
+                    Const, zip_const_t<Ts>, typename std::remove_reference<Ts>::type>::type>>::value
+                && std::is_same<
+                    zip_iterator_t<typename std::conditional<
+                        Const, zip_const_t<Ts>, typename std::remove_reference<Ts>::type>::type>,
+                    zip_sentinel_t<typename std::conditional<
+                        Const, zip_const_t<Ts>,
+                        typename std::remove_reference<Ts>::type>::type>>::value)...>;
+
+            using sentinel = typename std::conditional<
+                is_sized<false>::value, iterator,
+                ZipSentinel<zip_sentinel_t<typename std::remove_reference<Ts>::type>...>>::type;
+            using const_sentinel =
+                typename std::conditional<is_sized<true>::value, const_iterator,
+                                          ZipSentinel<zip_sentinel_t<zip_const_t<Ts>>...>>::type;
+
+            std::tuple<zip_storage_t<Ts>...> iterables;
+
+            /**
+             * @brief get<I>
+             *
+             * Returns the `I`-th input.
+             *
+             * @tparam I
+             */
+            template <size_t I> auto get() -> decltype(zip_unwrap(std::get<I>(iterables))) {
+                return zip_unwrap(std::get<I>(this->iterables));
+            }
+
+            /**
+             * @brief get<I>
+             *
+             * @tparam I
+             */
+            template <size_t I> auto get() const -> decltype(zip_unwrap(
+                std::get<I>(std::declval<const std::tuple<zip_storage_t<Ts>...> &>()))) {
+                return zip_unwrap(std::get<I>(this->iterables));
+            }
+
+            /**
+             * @brief begin
+             *
+             * @return iterator
+             */
+            auto begin() -> iterator { return this->make_begin<iterator>(*this, indices{}); }
+
+            /**
+             * @brief begin
+             *
+             * @return const_iterator
+             */
+            auto begin() const -> const_iterator {
+                return this->make_begin<const_iterator>(*this, indices{});
+            }
+
+            /**
+             * @brief end
+             *
+             * @return sentinel
+             */
+            auto end() -> sentinel {
+                return this->make_end<sentinel>(*this, indices{}, is_sized<false>{});
+            }
+
+            /**
+             * @brief end
+             *
+             * @return const_sentinel
+             */
+            auto end() const -> const_sentinel {
+                return this->make_end<const_sentinel>(*this, indices{}, is_sized<true>{});
+            }
+
+            /**
+             * @brief size
+             *
+             * The length of the shortest input. Only available when all inputs are
+             * random-access common ranges.
+             *
+             * @return size_t
+             */
+            auto size() const -> size_t { return this->min_size(*this, indices{}); }
+
+          private:
+            using indices = std::index_sequence_for<Ts...>;
+
+            template <typename Iter, typename Self, size_t... I>
+            static auto make_begin(Self &self, std::index_sequence<I...> /* unused */) -> Iter {
+                return Iter{std::make_tuple(std::begin(self.template get<I>())...)};
+            }
+
+            template <typename Sent, typename Self, size_t... I>
+            static auto make_end(Self &self, std::index_sequence<I...> /* unused */,
+                                 std::true_type /* sized */) -> Sent {
+                const auto n = static_cast<std::ptrdiff_t>(min_size(self, indices{}));
+                return Sent{std::make_tuple(std::next(std::begin(self.template get<I>()), n)...)};
+            }
+
+            template <typename Sent, typename Self, size_t... I>
+            static auto make_end(Self &self, std::index_sequence<I...> /* unused */,
+                                 std::false_type /* sized */) -> Sent {
+                return Sent{std::make_tuple(std::end(self.template get<I>())...)};
+            }
+
+            template <typename Self, size_t... I>
+            static auto min_size(Self &self, std::index_sequence<I...> /* unused */) -> size_t {
+                auto n = static_cast<size_t>(-1);
+                (void)std::initializer_list<int>{
+                    (n = std::min(n, static_cast<size_t>(std::end(self.template get<I>())
+                                                         - std::begin(self.template get<I>()))),
+                     0)...};
+                return n;
+            }
+        };
+
+        template <typename Body, typename... Ts>
+        void for_each_zip_impl(size_t n, Body &body, Ts *__restrict... data) {
+            for (size_t i = 0; i != n; ++i) {
+                body(data[i]...);
+            }
+        }
+
+        template <typename Body, typename Self, size_t... I>
+        void for_each_zip_contiguous(Self &self, Body &body,
+                                     std::index_sequence<I...> /* unused */) {
+            for_each_zip_impl(self.size(), body, self.template get<I>().data()...);
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief zip(iterables...)
+     *
+     * The `zip()` function walks several containers or ranges in lockstep, as
+     * Python's `zip` does, and yields a `std::tuple` of references to their
+     * current elements. It stops at the end of the shortest input. The result is
+     * a random-access range when all inputs are. Lvalue inputs are referred to
+     * and rvalue inputs are moved into the result.
+     *
+     * @tparam T
+     * @tparam Ts
+     * @param[in] iterable
+     * @param[in] iterables
+     * @return detail::ZipIterableWrapper<T, Ts...>
+     */
+    template <typename T, typename... Ts>
+    inline auto zip(T &&iterable, Ts &&...iterables) -> detail::ZipIterableWrapper<T, Ts...> {
+        return detail::ZipIterableWrapper<T, Ts...>{
+            std::tuple<detail::zip_storage_t<T>, detail::zip_storage_t<Ts>...>{
+                std::forward<T>(iterable), std::forward<Ts>(iterables)...}};
+    }
+
+    /**
+     * @brief for_each_zip(zip(containers...), Body &&body)
+     *
+     * The `for_each_zip` function calls `body(a[i], b[i], ...)` for every index
+     * of a zip of contiguous containers (ones with `data()` and `size()`). The
+     * loop runs over `__restrict` pointers to the data, which tells the compiler
+     * that the containers do not overlap, so it can vectorize without run-time
+     * alias checks. The containers must therefore be distinct.
+     *
+     * @tparam Ts
+     * @tparam Body
+     * @param[in] zipped
+     * @param[in] body
+     */
+    template <typename... Ts, typename Body>
+    inline auto for_each_zip(const detail::ZipIterableWrapper<Ts...> &zipped, Body &&body) ->
+        typename std::enable_if<detail::all_true<
+            detail::is_contiguous<detail::zip_const_t<Ts>>::value...>::value>::type {
+        detail::for_each_zip_contiguous(zipped, body, std::index_sequence_for<Ts...>{});
+    }
+
+}  // namespace py
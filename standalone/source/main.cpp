@@ -1,30 +1,215 @@
-#include <pyrange/greeter.h>
+#include <pyrange/enumerate.hpp>
+#include <pyrange/range.hpp>
+#include <pyrange/robin.hpp>
 #include <pyrange/version.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <cxxopts.hpp>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
+#include <thread>
+#include <utility>
+#include <vector>
 
-auto main(int argc, char **argv) -> int {
-    const std::unordered_map<std::string, pyrange::LanguageCode> languages{
-        {"en", pyrange::LanguageCode::EN},
-        {"de", pyrange::LanguageCode::DE},
-        {"es", pyrange::LanguageCode::ES},
-        {"fr", pyrange::LanguageCode::FR},
+namespace {
+
+    // A kernel runs one repetition over `n` items and returns a checksum, so that
+    // the work cannot be optimized away. Each thread owns its kernel state.
+
+    struct Kernel {
+        virtual ~Kernel() = default;
+        virtual auto run() -> uint64_t = 0;
+    };
+
+    // sum of an array, indexed through py::range
+    struct RangeSum : Kernel {
+        std::vector<uint32_t> data;
+
+        explicit RangeSum(size_t n) : data(n) {
+            for (auto i : py::range(n)) {
+                this->data[i] = uint32_t(i * 2654435761U);
+            }
+        }
+
+        auto run() -> uint64_t override {
+            auto total = uint64_t(0);
+            for (auto i : py::range(this->data.size())) {
+                total += this->data[i];
+            }
+            return total;
+        }
+    };
+
+    // read-modify-write of every element through py::enumerate
+    struct EnumerateScan : Kernel {
+        std::vector<uint32_t> data;
+
+        explicit EnumerateScan(size_t n) : data(n, 1U) {}
+
+        auto run() -> uint64_t override {
+            for (const auto &p : py::enumerate(this->data)) {
+                p.second += uint32_t(p.first);
+            }
+            return this->data.back();
+        }
     };
 
-    cxxopts::Options options(*argv, "A program to welcome the world!");
+    // `n` items handed out to the parts in round-robin order, never twice in a
+    // row to the same part, as a multiway partitioner does (at least 2 parts)
+    template <typename Robin> struct RobinDispatch : Kernel {
+        size_t num_items;
+        Robin rr;
+        uint32_t from = 0;
+
+        RobinDispatch(size_t n, Robin rr) : num_items(n), rr(std::move(rr)) {}
+
+        auto run() -> uint64_t override {
+            auto total = uint64_t(0);
+            auto remaining = this->num_items;
+            while (remaining != 0) {
+                auto last = this->from;
+                for (auto part : this->rr.exclude(this->from)) {
+                    total += part;
+                    last = part;
+                    if (--remaining == 0) {
+                        break;
+                    }
+                }
+                this->from = last;
+            }
+            return total;
+        }
+    };
+
+    auto make_kernel(const std::string &name, size_t n, uint32_t parts) -> std::unique_ptr<Kernel> {
+        if (name == "range-sum") {
+            return std::unique_ptr<Kernel>(new RangeSum(n));
+        }
+        if (name == "enumerate-scan") {
+            return std::unique_ptr<Kernel>(new EnumerateScan(n));
+        }
+        if (name == "robin-dispatch") {
+            using Robin = fun::Robin<uint32_t>;
+            return std::unique_ptr<Kernel>(new RobinDispatch<Robin>(n, Robin(parts)));
+        }
+        if (name == "weighted-dispatch") {
+            using Robin = fun::WeightedRobin<uint32_t>;
+            auto weights = std::vector<size_t>(parts);
+            for (auto p : py::range(parts)) {
+                weights[p] = 1 + p % 4;
+            }
+            return std::unique_ptr<Kernel>(new RobinDispatch<Robin>(n, Robin(weights)));
+        }
+        return nullptr;
+    }
+
+    // nearest-rank percentile of sorted samples
+    auto percentile(const std::vector<double> &sorted, double q) -> double {
+        const auto rank = size_t(q * double(sorted.size() - 1) + 0.5);
+        return sorted[rank];
+    }
+
+    struct Report {
+        std::string kernel;
+        size_t n;
+        size_t repeat;
+        double wall;                               // seconds
+        std::vector<std::vector<double>> samples;  // seconds per repetition, per thread
+        uint64_t checksum;
+    };
+
+    auto items_per_second(size_t items, double seconds) -> double {
+        return seconds > 0.0 ? double(items) / seconds : 0.0;
+    }
+
+    auto mean(const std::vector<double> &xs) -> double {
+        auto sum = 0.0;
+        for (auto x : xs) {
+            sum += x;
+        }
+        return sum / double(xs.size());
+    }
+
+    void print_text(const Report &r) {
+        auto all = std::vector<double>{};
+        for (const auto &s : r.samples) {
+            all.insert(all.end(), s.begin(), s.end());
+        }
+        std::sort(all.begin(), all.end());
+        const auto threads = r.samples.size();
+        std::cout << "kernel " << r.kernel << ", n = " << r.n << ", " << threads
+                  << " thread(s), " << r.repeat << " repetition(s)\n"
+                  << "throughput: " << items_per_second(threads * r.repeat * r.n, r.wall)
+                  << " items/s\n"
+                  << "seconds per repetition: p50 " << percentile(all, 0.50) << ", p90 "
+                  << percentile(all, 0.90) << ", p99 " << percentile(all, 0.99) << ", max "
+                  << all.back() << "\n";
+        for (auto t : py::range(threads)) {
+            const auto m = mean(r.samples[t]);
+            std::cout << "thread " << t << ": mean " << m << " s, "
+                      << items_per_second(r.n, m) << " items/s\n";
+        }
+        std::cout << "checksum: " << r.checksum << std::endl;
+    }
+
+    void print_json(const Report &r) {
+        auto all = std::vector<double>{};
+        for (const auto &s : r.samples) {
+            all.insert(all.end(), s.begin(), s.end());
+        }
+        std::sort(all.begin(), all.end());
+        const auto threads = r.samples.size();
+        std::cout << "{\n"
+                  << "  \"kernel\": \"" << r.kernel << "\",\n"
+                  << "  \"n\": " << r.n << ",\n"
+                  << "  \"threads\": " << threads << ",\n"
+                  << "  \"repeat\": " << r.repeat << ",\n"
+                  << "  \"items_per_second\": "
+                  << items_per_second(threads * r.repeat * r.n, r.wall) << ",\n"
+                  << "  \"seconds\": {\"p50\": " << percentile(all, 0.50)
+                  << ", \"p90\": " << percentile(all, 0.90) << ", \"p99\": "
+                  << percentile(all, 0.99) << ", \"max\": " << all.back() << "},\n"
+                  << "  \"per_thread\": [";
+        for (auto t : py::range(threads)) {
+            const auto m = mean(r.samples[t]);
+            std::cout << (t == 0 ? "\n" : ",\n") << "    {\"thread\": " << t
+                      << ", \"mean_seconds\": " << m
+                      << ", \"items_per_second\": " << items_per_second(r.n, m) << "}";
+        }
+        std::cout << "\n  ],\n"
+                  << "  \"checksum\": " << r.checksum << "\n"
+                  << "}" << std::endl;
+    }
 
-    std::string language;
-    std::string name;
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+    cxxopts::Options options(*argv, "Runs pyrange kernels and reports their throughput");
+
+    std::string kernel;
+    size_t n;
+    size_t threads;
+    size_t repeat;
+    uint32_t parts;
 
     // clang-format off
   options.add_options()
     ("h,help", "Show help")
     ("v,version", "Print the current version number")
-    ("n,name", "Name to greet", cxxopts::value(name)->default_value("World"))
-    ("l,lang", "Language code to use", cxxopts::value(language)->default_value("en"))
+    ("k,kernel", "Kernel to run: range-sum, enumerate-scan, robin-dispatch, weighted-dispatch",
+     cxxopts::value(kernel)->default_value("range-sum"))
+    ("n,items", "Items per repetition", cxxopts::value(n)->default_value("1000000"))
+    ("t,threads", "Threads running the kernel side by side",
+     cxxopts::value(threads)->default_value("1"))
+    ("r,repeat", "Timed repetitions per thread", cxxopts::value(repeat)->default_value("10"))
+    ("p,parts", "Parts of the robin kernels", cxxopts::value(parts)->default_value("64"))
+    ("j,json", "Print the report as JSON")
   ;
     // clang-format on
 
@@ -40,14 +225,74 @@ auto main(int argc, char **argv) -> int {
         return 0;
     }
 
-    auto langIt = languages.find(language);
-    if (langIt == languages.end()) {
-        std::cerr << "unknown language code: " << language << std::endl;
+    if (n == 0 || threads == 0 || repeat == 0) {
+        std::cerr << "--items, --threads and --repeat must be positive" << std::endl;
+        return 1;
+    }
+
+    if (parts < 2) {
+        std::cerr << "--parts must be at least 2" << std::endl;
         return 1;
     }
 
-    // pyrange::PyRange pyrange(name);
-    // std::cout << pyrange.greet(langIt->second) << std::endl;
+    auto kernels = std::vector<std::unique_ptr<Kernel>>{};
+    for (auto t = size_t(0); t != threads; ++t) {
+        kernels.push_back(make_kernel(kernel, n, parts));
+        if (!kernels.back()) {
+            std::cerr << "unknown kernel: " << kernel << std::endl;
+            return 1;
+        }
+    }
+
+    using clock = std::chrono::steady_clock;
+    auto report = Report{kernel, n, repeat, 0.0, {}, 0};
+    report.samples.assign(threads, std::vector<double>(repeat));
+    auto checksums = std::vector<uint64_t>(threads);
+    // the threads warm up, then block until all of them are ready and the clock starts
+    std::mutex gate;
+    std::condition_variable gate_changed;
+    auto ready = size_t(0);
+    auto go = false;
 
+    auto worker = [&](size_t t) {
+        kernels[t]->run();  // warm up
+        {
+            std::unique_lock<std::mutex> lock(gate);
+            ++ready;
+            gate_changed.notify_all();
+            gate_changed.wait(lock, [&go] { return go; });
+        }
+        for (auto k = size_t(0); k != repeat; ++k) {
+            const auto start = clock::now();
+            checksums[t] += kernels[t]->run();
+            report.samples[t][k] = std::chrono::duration<double>(clock::now() - start).count();
+        }
+    };
+
+    auto pool = std::vector<std::thread>{};
+    for (auto t = size_t(0); t != threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    auto start = clock::time_point{};
+    {
+        std::unique_lock<std::mutex> lock(gate);
+        gate_changed.wait(lock, [&ready, threads] { return ready == threads; });
+        start = clock::now();
+        go = true;
+    }
+    gate_changed.notify_all();
+    for (auto &th : pool) {
+        th.join();
+    }
+    report.wall = std::chrono::duration<double>(clock::now() - start).count();
+    for (auto c : checksums) {
+        report.checksum += c;
+    }
+
+    if (result["json"].as<bool>()) {
+        print_json(report);
+    } else {
+        print_text(report);
+    }
     return 0;
 }
@@ -0,0 +1,124 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <array>                  // for array
+#include <cstddef>                // for size_t
+#include <cstdint>                // for int32_t
+#include <limits>                 // for numeric_limits
+#include <pyrange/batch.hpp>      // for for_each_batch, Batch
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/range.hpp>      // for range
+#include <type_traits>            // for is_same
+#include <vector>                 // for vector
+
+TEST_CASE("Test for_each_batch (Range)") {
+    static_assert(py::simd_width<char> == 4 * py::simd_width<int>, "lanes follow the type size");
+
+    auto seen = std::vector<int>(37, 0);
+    auto batches = 0;
+    py::for_each_batch<8>(py::range(3, 40), [&](const py::Batch<int, 8> &b) {
+        for (size_t k = 0; k != b.size(); ++k) {
+            seen[size_t(b[k] - 3)] += 1;
+        }
+        for (size_t k = 1; k != 8; ++k) {
+            CHECK(b[k] == (b.active(k) ? b[k - 1] + 1 : b[k - 1]));
+        }
+        ++batches;
+    });
+    CHECK(batches == 5);
+    for (auto s : seen) {
+        CHECK(s == 1);
+    }
+
+    auto total = 0L;
+    py::for_each_batch(py::range(1000), [&total](const auto &b) {
+        for (size_t k = 0; k != b.size(); ++k) {
+            total += b[k];
+        }
+    });
+    CHECK(total == 999L * 1000L / 2);
+
+    auto count = 0;
+    py::for_each_batch(py::range(0), [&count](const auto &) { ++count; });
+    CHECK(count == 0);
+
+    // no value past the end is computed, which would overflow here
+    const auto top = std::numeric_limits<int>::max();
+    auto last = 0;
+    py::for_each_batch<8>(py::range(top - 20, top), [&](const py::Batch<int, 8> &b) {
+        for (size_t k = 0; k != 8; ++k) {
+            if (b.active(k)) {
+                last = b[k];
+                ++count;
+            }
+        }
+    });
+    CHECK(count == 20);
+    CHECK(last == top - 1);
+}
+
+TEST_CASE("Test for_each_batch (width not a power of two)") {
+    // the lanes are aligned to the largest power of two that divides their size
+    static_assert(py::detail::lowest_bit(3 * sizeof(int)) == sizeof(int), "");
+    static_assert(py::detail::lowest_bit(8 * sizeof(int)) == 8 * sizeof(int), "");
+    auto values = std::vector<int>{};
+    py::for_each_batch<3>(py::range(10), [&values](const py::Batch<int, 3> &b) {
+        for (size_t k = 0; k != b.size(); ++k) {
+            values.push_back(b[k]);
+        }
+    });
+    CHECK(values == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+TEST_CASE("Test for_each_batch (StepRange)") {
+    auto values = std::vector<int>{};
+    py::for_each_batch<4>(py::range(20, 0, -3), [&values](const py::Batch<int, 4> &b) {
+        for (size_t k = 0; k != b.size(); ++k) {
+            values.push_back(b[k]);
+        }
+    });
+    CHECK(values == std::vector<int>{20, 17, 14, 11, 8, 5, 2});
+}
+
+TEST_CASE("Test for_each_batch (enumerate)") {
+    auto A = std::vector<float>(19, 1.0F);
+    py::for_each_batch<8>(py::enumerate(A), [](const auto &idx, const auto &elem) {
+        for (size_t k = 0; k != elem.size(); ++k) {
+            elem[k] += float(idx[k]);
+        }
+    });
+    for (const auto &p : py::enumerate(A)) {
+        CHECK(p.second == 1.0F + float(p.first));
+    }
+
+    const auto B = std::array<double, 5>{1.0, 2.0, 3.0, 4.0, 5.0};
+    auto total = 0.0;
+    py::for_each_batch(py::const_enumerate(B), [&total](const auto &idx, const auto &elem) {
+        for (size_t k = 0; k != elem.size(); ++k) {
+            total += double(idx[k]) * elem[k];
+        }
+    });
+    CHECK(total == 40.0);
+}
+
+TEST_CASE("Test for_each_batch (enumerate with index type and start)") {
+    auto A = std::vector<int32_t>(11, 0);
+    py::for_each_batch<4>(py::enumerate<int32_t>(A, 100), [](const auto &idx, const auto &elem) {
+        static_assert(std::is_same<decltype(idx[0]), const int32_t &>::value, "");
+        for (size_t k = 0; k != elem.size(); ++k) {
+            elem[k] = idx[k];
+        }
+    });
+    for (const auto &p : py::enumerate(A)) {
+        CHECK(A[p.first] == int32_t(p.first) + 100);
+    }
+
+    // no tail: the indices stop at the last full batch
+    auto B = std::vector<int32_t>(16, 0);
+    py::for_each_batch<4>(py::enumerate<int32_t>(B, 7), [](const auto &idx, const auto &elem) {
+        for (size_t k = 0; k != elem.size(); ++k) {
+            elem[k] = idx[k];
+        }
+    });
+    CHECK(B.front() == 7);
+    CHECK(B.back() == 22);
+}
@@ -0,0 +1,120 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <array>                  // for array
+#include <atomic>                 // for atomic
+#include <iterator>               // for iterator_traits, random_access_iterator_tag
+#include <pyrange/chunks.hpp>     // for chunks, windows
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/parallel.hpp>   // for parallel_for
+#include <pyrange/range.hpp>      // for range
+#include <type_traits>            // for is_same
+#include <vector>                 // for vector
+
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // for views
+#endif
+
+TEST_CASE("Test chunks") {
+    auto v = std::vector<int>{0, 1, 2, 3, 4, 5, 6};
+    auto c = py::chunks(v, 3);
+    CHECK(c.size() == 3);
+    auto sizes = std::vector<size_t>{};
+    auto first = std::vector<int>{};
+    for (auto chunk : c) {
+        sizes.push_back(chunk.size());
+        first.push_back(chunk[0]);
+    }
+    CHECK(sizes == std::vector<size_t>{3, 3, 1});  // the tail chunk
+    CHECK(first == std::vector<int>{0, 3, 6});
+
+    // no copy: the chunks alias the container
+    for (auto chunk : py::chunks(v, 2)) {
+        for (auto &x : chunk) {
+            x *= 10;
+        }
+    }
+    CHECK(v == std::vector<int>{0, 10, 20, 30, 40, 50, 60});
+    CHECK(c[1].data() == v.data() + 3);
+
+    CHECK(py::chunks(v, 7).size() == 1);
+    CHECK(py::chunks(v, 100).size() == 1);
+    CHECK(py::chunks(v, 100)[0].size() == 7);
+    CHECK(py::chunks(v, 0).empty());
+    auto empty = std::vector<int>{};
+    CHECK(py::chunks(empty, 4).empty());
+
+    const auto &cv = v;
+    auto cc = py::chunks(cv, 4);
+    static_assert(std::is_same<decltype(cc[0].data()), const int *>::value, "const elements");
+    CHECK(cc[1].size() == 3);
+}
+
+TEST_CASE("Test chunks (random access)") {
+    auto a = std::array<double, 10>{};
+    auto c = py::chunks(a, 4);
+    using It = decltype(c.begin());
+    static_assert(std::is_same<std::iterator_traits<It>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "random access");
+    CHECK(c.end() - c.begin() == 3);
+    CHECK((*(c.begin() + 2)).size() == 2);
+    CHECK(c.begin()[1].data() == a.data() + 4);
+    auto it = c.end();
+    --it;
+    CHECK((*it).size() == 2);
+    CHECK(c.begin() < it);
+}
+
+TEST_CASE("Test chunks (enumerate)") {
+    auto v = std::vector<int>(10);
+    for (const auto &p : py::enumerate(py::chunks(v, 4))) {
+        for (auto &x : p.second) {
+            x = int(p.first);
+        }
+    }
+    CHECK(v == std::vector<int>{0, 0, 0, 0, 1, 1, 1, 1, 2, 2});
+}
+
+TEST_CASE("Test chunks (parallel)") {
+    auto v = std::vector<int>(10007, 1);
+    std::atomic<int> total{0};
+    py::parallel_for(
+        py::chunks(v, 64),
+        [&total](py::span<int> chunk) {
+            auto sum = 0;
+            for (auto x : chunk) {
+                sum += x;
+            }
+            total += sum;
+        },
+        4);
+    CHECK(total == 10007);
+}
+
+TEST_CASE("Test windows") {
+    auto v = std::vector<int>{1, 2, 3, 4, 5};
+    auto sums = std::vector<int>{};
+    for (auto w : py::windows(v, 3)) {
+        CHECK(w.size() == 3);
+        sums.push_back(w[0] + w[1] + w[2]);
+    }
+    CHECK(sums == std::vector<int>{6, 9, 12});
+    CHECK(py::windows(v, 5).size() == 1);
+    CHECK(py::windows(v, 6).empty());
+    CHECK(py::windows(v, 0).empty());
+    CHECK(py::windows(v, 1).size() == 5);
+    CHECK(py::windows(v, 2)[3].data() == v.data() + 3);
+}
+
+#if defined(__cpp_lib_ranges)
+TEST_CASE("Test chunks (C++20 views)") {
+    auto v = std::vector<int>{1, 2, 3, 4, 5};
+    static_assert(std::ranges::random_access_range<decltype(py::chunks(v, 2))>);
+    static_assert(std::ranges::borrowed_range<decltype(py::chunks(v, 2))>);
+    auto sizes = std::vector<size_t>{};
+    for (auto s : py::chunks(v, 2) | std::views::transform([](auto c) { return c.size(); })) {
+        sizes.push_back(s);
+    }
+    CHECK(sizes == std::vector<size_t>{2, 2, 1});
+}
+#endif
@@ -0,0 +1,123 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <array>              // for array
+#include <cstdint>            // for uint64_t
+#include <cstdlib>            // for abs
+#include <pyrange/curve.hpp>  // for morton, hilbert
+#include <pyrange/range.hpp>  // for range
+#include <stdexcept>          // for length_error
+#include <vector>             // for vector
+
+TEST_CASE("Test morton") {
+    const auto R = py::morton(py::range(4), py::range(4));
+    CHECK(R.size() == 16);
+
+    auto order = std::vector<std::array<int, 2>>{};
+    for (const auto &idx : R) {
+        order.push_back(idx);
+    }
+    CHECK(order.size() == 16);
+    // bit 0 of the curve index is the first coordinate
+    CHECK(order[0] == std::array<int, 2>{0, 0});
+    CHECK(order[1] == std::array<int, 2>{1, 0});
+    CHECK(order[2] == std::array<int, 2>{0, 1});
+    CHECK(order[3] == std::array<int, 2>{1, 1});
+    CHECK(order[4] == std::array<int, 2>{2, 0});
+    CHECK(order[15] == std::array<int, 2>{3, 3});
+    for (auto k = 0U; k != 16; ++k) {
+        CHECK(R.curve_index(order[k]) == k);
+    }
+}
+
+TEST_CASE("Test morton (non-power-of-two, 3D)") {
+    const auto R = py::morton(py::range(1, 6), py::range(-2, 1), py::range(7));
+    CHECK(R.size() == 105);
+
+    auto seen = std::vector<int>(5 * 3 * 7, 0);
+    auto last = std::uint64_t(0);
+    auto count = 0;
+    for (auto it = R.begin(); it != R.end(); ++it) {
+        const auto &idx = *it;
+        CHECK(R.contains(idx));
+        CHECK(R.curve_index(idx) == it.curve_index());
+        CHECK((count == 0 || it.curve_index() > last));
+        last = it.curve_index();
+        seen[size_t(((idx[0] - 1) * 3 + idx[1] + 2) * 7 + idx[2])] += 1;
+        ++count;
+    }
+    CHECK(count == 105);
+    for (auto s : seen) {
+        CHECK(s == 1);
+    }
+
+    CHECK(py::morton(py::range(0), py::range(5)).empty());
+    CHECK(py::morton(py::range(1), py::range(1)).size() == 1);
+}
+
+TEST_CASE("Test hilbert") {
+    for (auto n : {2, 8, 32}) {
+        const auto R = py::hilbert(py::range(n), py::range(n));
+        auto prev = std::array<int, 2>{0, 0};
+        auto count = 0;
+        for (const auto &idx : R) {
+            if (count != 0) {
+                // consecutive cells are neighbours
+                CHECK(std::abs(idx[0] - prev[0]) + std::abs(idx[1] - prev[1]) == 1);
+            }
+            CHECK(R.curve_index(idx) == std::uint64_t(count));
+            prev = idx;
+            ++count;
+        }
+        CHECK(count == n * n);
+    }
+
+    const auto C = py::hilbert(py::range(4), py::range(4), py::range(4));
+    auto prev = std::array<int, 3>{0, 0, 0};
+    auto count = 0;
+    for (const auto &idx : C) {
+        if (count != 0) {
+            CHECK(std::abs(idx[0] - prev[0]) + std::abs(idx[1] - prev[1])
+                      + std::abs(idx[2] - prev[2])
+                  == 1);
+        }
+        prev = idx;
+        ++count;
+    }
+    CHECK(count == 64);
+}
+
+TEST_CASE("Test hilbert (non-power-of-two)") {
+    const auto R = py::hilbert(py::range(10, 23), py::range(5));
+    auto seen = std::vector<int>(13 * 5, 0);
+    auto count = 0;
+    for (const auto &idx : R) {
+        seen[size_t((idx[0] - 10) * 5 + idx[1])] += 1;
+        ++count;
+    }
+    CHECK(count == 65);
+    for (auto s : seen) {
+        CHECK(s == 1);
+    }
+}
+
+TEST_CASE("Test curve (largest extents)") {
+    // the curve index of a 2^21-cube fills 63 bits
+    const auto R = py::morton(py::range(1 << 21), py::range(1 << 21), py::range(1 << 21));
+    CHECK(R.bits == 21);
+    CHECK(R.code_end == std::uint64_t(1) << 63);
+    CHECK(*R.begin() == std::array<int, 3>{0, 0, 0});
+    CHECK(R.curve_index({(1 << 21) - 1, (1 << 21) - 1, (1 << 21) - 1}) == R.code_end - 1);
+
+    const auto H = py::hilbert(py::range(std::int64_t(1) << 31), py::range(std::int64_t(3)));
+    CHECK(H.bits == 31);
+    CHECK(H.code_end == std::uint64_t(1) << 62);
+    CHECK(H.contains(*H.begin()));
+
+    // one more value would not fit into the curve index
+    CHECK_THROWS_AS(py::morton(py::range((1 << 21) + 1), py::range(2), py::range(2)),
+                    std::length_error);
+    CHECK_THROWS_AS(py::hilbert(py::range(3000000), py::range(2), py::range(2)),
+                    std::length_error);
+    CHECK_THROWS_AS(py::morton(py::range((std::int64_t(1) << 31) + 1), py::range(std::int64_t(2))),
+                    std::length_error);
+}
@@ -0,0 +1,127 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>               // for minmax_element
+#include <cstddef>                 // for size_t
+#include <pyrange/distribute.hpp>  // for distribute, distribution, Block, Cyclic
+#include <pyrange/range.hpp>       // for range
+#include <thread>                  // for thread
+#include <vector>                  // for vector
+
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // for views
+#endif
+
+namespace {
+
+    // only the block and cyclic parts are balanced to within one element
+    auto is_balanced(py::Block /* unused */) -> bool { return true; }
+    auto is_balanced(py::Cyclic /* unused */) -> bool { return true; }
+    auto is_balanced(py::BlockCyclic /* unused */) -> bool { return false; }
+
+    // Runs every rank as a thread that marks the elements of its part, and
+    // checks that each element of `rng` is marked exactly once, by its owner,
+    // at its local index.
+    template <typename Policy> void check_cover(py::Range<int> rng, size_t nranks,
+                                                Policy policy) {
+        const auto dist = py::distribution(rng, nranks, policy);
+        auto owner = std::vector<size_t>(rng.size(), nranks);
+        auto local = std::vector<size_t>(rng.size(), 0);
+        auto hits = std::vector<int>(rng.size(), 0);
+        auto sizes = std::vector<size_t>(nranks, 0);
+
+        auto threads = std::vector<std::thread>{};
+        for (auto rank : py::range(nranks)) {
+            threads.emplace_back([&, rank]() {
+                const auto part = py::distribute(rng, rank, nranks, policy);
+                auto j = size_t(0);
+                for (auto x : part) {
+                    const auto i = size_t(x - rng.start);  // disjoint, so no race
+                    ++hits[i];
+                    owner[i] = rank;
+                    local[i] = j;
+                    CHECK(part[j] == x);
+                    CHECK(part.contains(x));
+                    ++j;
+                }
+                sizes[rank] = j;
+                CHECK(part.size() == j);
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+
+        for (auto i : py::range(rng.size())) {
+            CHECK(hits[i] == 1);
+            CHECK(dist.owner(i) == owner[i]);
+            CHECK(dist.local(i) == local[i]);
+            CHECK(dist.global(owner[i], local[i]) == i);
+        }
+        if (is_balanced(policy)) {
+            const auto minmax = std::minmax_element(sizes.begin(), sizes.end());
+            CHECK(*minmax.second - *minmax.first <= 1);
+        }
+    }
+
+}  // namespace
+
+TEST_CASE("Test distribute (block)") {
+    auto part = py::distribute(py::range(10), 0, 3, py::Block{});
+    CHECK(part.start == 0);
+    CHECK(part.stop == 4);
+    part = py::distribute(py::range(10), 2, 3, py::Block{});
+    CHECK(part.start == 7);
+    CHECK(part.stop == 10);
+    CHECK(py::distribute(py::range(5, 7), 3, 4, py::Block{}).empty());
+
+    for (auto n : {0, 1, 7, 64, 100, 101}) {
+        for (auto p : {1, 2, 3, 8, 13}) {
+            check_cover(py::range(-3, n - 3), size_t(p), py::Block{});
+        }
+    }
+}
+
+TEST_CASE("Test distribute (cyclic)") {
+    auto part = py::distribute(py::range(10), 1, 3, py::Cyclic{});
+    CHECK(std::vector<int>(part.begin(), part.end()) == std::vector<int>{1, 4, 7});
+    CHECK(py::distribute(py::range(2), 2, 3, py::Cyclic{}).empty());
+
+    for (auto n : {0, 1, 7, 64, 100, 101}) {
+        for (auto p : {1, 2, 3, 8, 13}) {
+            check_cover(py::range(5, n + 5), size_t(p), py::Cyclic{});
+        }
+    }
+}
+
+TEST_CASE("Test distribute (block-cyclic)") {
+    // blocks of 2 over 3 ranks: [0 1] [2 3] [4 5] [6 7] [8 9] [10]
+    auto part = py::distribute(py::range(11), 0, 3, py::BlockCyclic{2});
+    CHECK(std::vector<int>(part.begin(), part.end()) == std::vector<int>{0, 1, 6, 7});
+    part = py::distribute(py::range(11), 2, 3, py::BlockCyclic{2});
+    CHECK(std::vector<int>(part.begin(), part.end()) == std::vector<int>{4, 5, 10});
+    CHECK(part.end() - part.begin() == 3);
+    CHECK(*(part.begin() + 2) == 10);
+    CHECK(*(part.end() - 3) == 4);
+    CHECK(!part.contains(6));
+
+    for (auto n : {0, 1, 7, 64, 100, 101}) {
+        for (auto p : {1, 2, 3, 8}) {
+            for (auto k : {1, 2, 3, 16, 200}) {
+                check_cover(py::range(n), size_t(p), py::BlockCyclic{size_t(k)});
+            }
+        }
+    }
+}
+
+#if defined(__cpp_lib_ranges)
+TEST_CASE("Test distribute (C++20 views)") {
+    static_assert(std::ranges::random_access_range<py::BlockCyclicRange<int>>);
+    static_assert(std::ranges::borrowed_range<py::BlockCyclicRange<int>>);
+    auto part = py::distribute(py::range(20), 1, 2, py::BlockCyclic{3});
+    auto out = std::vector<int>{};
+    for (auto x : part | std::views::reverse | std::views::take(4)) {
+        out.push_back(x);
+    }
+    CHECK(out == std::vector<int>{17, 16, 15, 11});
+}
+#endif
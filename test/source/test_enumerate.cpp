@@ -1,8 +1,18 @@
 #include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
 
+#include <algorithm>              // for find_if
+#include <cstdint>                // for uint32_t, int16_t
+#include <iterator>               // for iterator_traits, random_access_iterator_tag
+#include <list>                   // for list
 #include <pyrange/enumerate.hpp>  // for enumerate, iterable_wrapper
 #include <pyrange/range.hpp>      // for range, iterable_wrapper
+#include <type_traits>            // for is_same
 #include <utility>                // for pair
+#include <vector>                 // for vector
+
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // for views
+#endif
 
 TEST_CASE("Test enumerate") {
     auto R = py::range(10);
@@ -14,3 +24,130 @@ TEST_CASE("Test enumerate") {
     }
     CHECK(count == R.size());
 }
+
+TEST_CASE("Test enumerate (random access)") {
+    auto v = std::vector<int>{5, 6, 7, 8, 9};
+    auto e = py::enumerate(v);
+    using Iter = decltype(e.begin());
+    static_assert(std::is_same<std::iterator_traits<Iter>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "enumerate keeps the iterator category");
+    CHECK(e.end() - e.begin() == 5);
+    CHECK((*(e.end() - 1)).first == 4);
+    CHECK(e.begin()[3].first == 3);
+    CHECK(e.begin()[3].second == 8);
+    CHECK(e.begin() < e.end());
+    const auto it = std::find_if(e.begin(), e.end(), [](const auto &p) { return p.second == 7; });
+    CHECK((*it).first == 2);
+    (*(it + 1)).second = 0;
+    CHECK(v[3] == 0);
+
+    const auto R = py::range(10, 20);
+    CHECK(py::enumerate(R).begin()[3].first == 3);
+    CHECK(py::enumerate(R).begin()[3].second == 13);
+}
+
+TEST_CASE("Test enumerate (bidirectional)") {
+    auto l = std::list<int>{1, 2, 3};
+    auto e = py::enumerate(l);
+    using Iter = decltype(e.begin());
+    static_assert(std::is_same<std::iterator_traits<Iter>::iterator_category,
+                               std::bidirectional_iterator_tag>::value,
+                  "enumerate keeps the iterator category");
+    auto it = e.begin();
+    ++it;
+    ++it;
+    CHECK((*it).first == 2);
+    --it;
+    CHECK((*it).first == 1);
+    CHECK((*it).second == 2);
+}
+
+TEST_CASE("Test enumerate (rvalue)") {
+    auto e = py::enumerate(std::vector<int>{3, 4, 5});  // owns the vector
+    auto count = size_t(0);
+    for (const auto &p : e) {
+        CHECK(p.first == count);
+        CHECK(p.second == int(count) + 3);
+        p.second = 0;
+        ++count;
+    }
+    CHECK(count == 3);
+    CHECK(e.base() == std::vector<int>{0, 0, 0});
+
+    auto total = size_t(0);
+    for (const auto &p : py::const_enumerate(std::vector<int>{1, 1, 1})) {
+        total += p.first * size_t(p.second);
+    }
+    CHECK(total == 3);
+}
+
+TEST_CASE("Test enumerate (index type and start)") {
+    auto v = std::vector<int>{5, 6, 7};
+    auto e = py::enumerate<uint32_t>(v, 1);
+    static_assert(std::is_same<decltype((*e.begin()).first), uint32_t>::value,
+                  "the index has the requested type");
+    auto count = uint32_t(1);
+    for (const auto &p : e) {
+        CHECK(p.first == count);
+        CHECK(p.second == v[count - 1]);
+        ++count;
+    }
+    CHECK(count == 4);
+    CHECK((*(e.end() - 1)).first == 3);
+    CHECK(e.begin()[2].first == 3);
+
+    auto l = std::list<int>{1, 2, 3};
+    auto total = 0;
+    for (const auto &p : py::const_enumerate<int16_t>(l, -1)) {
+        static_assert(std::is_same<decltype(p.first), int16_t>::value, "");
+        total += p.first * p.second;
+    }
+    CHECK(total == -1 * 1 + 0 * 2 + 1 * 3);
+}
+
+namespace {
+    // a NUL-terminated string, whose end is found by the sentinel
+    struct NulTerminated {
+        struct Sentinel {
+            friend auto operator==(const char *s, Sentinel) -> bool { return *s == '\0'; }
+            friend auto operator!=(const char *s, Sentinel) -> bool { return *s != '\0'; }
+        };
+
+        const char *str;
+
+        auto begin() const -> const char * { return this->str; }
+        auto end() const -> Sentinel { return Sentinel{}; }
+    };
+}  // namespace
+
+TEST_CASE("Test enumerate (sentinel)") {
+    auto count = size_t(0);
+    for (const auto &p : py::enumerate(NulTerminated{"abc"})) {
+        CHECK(p.first == count);
+        CHECK(p.second == "abc"[count]);
+        ++count;
+    }
+    CHECK(count == 3);
+}
+
+#if defined(__cpp_lib_ranges)
+TEST_CASE("Test enumerate (views)") {
+    auto v = std::vector<int>{1, 2, 3, 4, 5, 6};
+    static_assert(std::ranges::view<decltype(py::enumerate(v))>);
+    static_assert(std::ranges::borrowed_range<decltype(py::enumerate(v))>);
+    static_assert(std::ranges::random_access_range<decltype(py::enumerate(v))>);
+
+    auto odd = py::enumerate(v)
+               | std::views::filter([](const auto &p) { return p.second % 2 == 1; })
+               | std::views::transform([](const auto &p) { return p.first; });
+    CHECK(std::vector<size_t>(odd.begin(), odd.end()) == std::vector<size_t>{0, 2, 4});
+
+    auto count = size_t(0);
+    for (const auto &p : py::enumerate(std::views::iota(10) | std::views::take(3))) {
+        CHECK(p.second == int(count) + 10);
+        ++count;
+    }
+    CHECK(count == 3);
+}
+#endif
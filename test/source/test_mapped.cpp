@@ -0,0 +1,115 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <atomic>                 // for atomic
+#include <cstddef>                // for size_t
+#include <cstdio>                 // for remove
+#include <fstream>                // for ofstream
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/mapped.hpp>     // for mapped_lines, mapped_records
+#include <pyrange/parallel.hpp>   // for parallel_for
+#include <pyrange/range.hpp>      // for range
+#include <string>                 // for string
+#include <system_error>           // for system_error
+#include <vector>                 // for vector
+
+namespace {
+
+    // a file with the given contents, removed at the end of the test
+    struct TempFile {
+        std::string path;
+
+        TempFile(const std::string &name, const std::string &contents) : path(name) {
+            std::ofstream(this->path, std::ios::binary) << contents;
+        }
+        TempFile(const TempFile &) = delete;
+        auto operator=(const TempFile &) -> TempFile & = delete;
+        ~TempFile() { std::remove(this->path.c_str()); }
+    };
+
+    auto to_strings(const py::LineView &lines) -> std::vector<std::string> {
+        auto out = std::vector<std::string>{};
+        for (auto line : lines) {
+            out.emplace_back(line.data(), line.size());
+        }
+        return out;
+    }
+
+}  // namespace
+
+TEST_CASE("Test mapped_lines") {
+    const auto file = TempFile("pyrange_test_lines.txt", "first\n\nthird\r\nlast");
+    auto lines = py::mapped_lines(file.path);
+    CHECK(to_strings(lines.view())
+          == std::vector<std::string>{"first", "", "third\r", "last"});
+
+    auto numbers = std::vector<size_t>{};
+    for (const auto &p : py::enumerate(py::mapped_lines(file.path), 1)) {
+        numbers.push_back(p.first);
+        if (p.first == 3) {
+            CHECK(p.second.size() == 6);
+        }
+    }
+    CHECK(numbers == std::vector<size_t>{1, 2, 3, 4});
+}
+
+TEST_CASE("Test mapped_lines (newlines)") {
+    const auto a = TempFile("pyrange_test_a.txt", "a\nb\n");
+    CHECK(to_strings(py::mapped_lines(a.path).view()) == std::vector<std::string>{"a", "b"});
+    const auto b = TempFile("pyrange_test_b.txt", "\n");
+    CHECK(to_strings(py::mapped_lines(b.path).view()) == std::vector<std::string>{""});
+    const auto c = TempFile("pyrange_test_c.txt", "");
+    CHECK(py::mapped_lines(c.path).empty());
+    CHECK(to_strings(py::mapped_lines(c.path).view()).empty());
+
+    CHECK_THROWS_AS(py::mapped_lines("pyrange_test_missing.txt"), std::system_error);
+}
+
+TEST_CASE("Test mapped_lines (split)") {
+    auto text = std::string{};
+    for (auto i : py::range(1000)) {
+        text += std::string(size_t(i % 13), 'x') + "\n";
+    }
+    text += "tail";
+    const auto file = TempFile("pyrange_test_split.txt", text);
+    const auto lines = py::mapped_lines(file.path);
+    const auto all = to_strings(lines.view());
+    CHECK(all.size() == 1001);
+
+    for (auto parts : {1, 2, 3, 7, 64, 5000}) {
+        const auto pieces = lines.split(size_t(parts));
+        CHECK(pieces.size() <= size_t(parts));
+        auto joined = std::vector<std::string>{};
+        for (const auto &piece : pieces) {
+            for (auto &s : to_strings(piece)) {
+                joined.push_back(s);
+            }
+        }
+        CHECK(joined == all);
+    }
+
+    std::atomic<size_t> count{0};
+    const auto pieces = lines.split(4);
+    py::parallel_for(py::range(pieces.size()), [&](size_t k) {
+        for (auto line : pieces[k]) {
+            static_cast<void>(line);
+            ++count;
+        }
+    });
+    CHECK(count == 1001);
+}
+
+TEST_CASE("Test mapped_records") {
+    const auto file = TempFile("pyrange_test_records.txt", "aaaabbbbccccdd");
+    const auto records = py::mapped_records(file.path, 4);
+    CHECK(records.size() == 4);
+    CHECK(records[1] == py::string_view("bbbb", 4));
+    CHECK(records[3].size() == 2);
+    CHECK(records.end() - records.begin() == 4);
+
+    std::atomic<size_t> bytes{0};
+    py::parallel_for(records, [&bytes](py::string_view r) { bytes += r.size(); }, 1);
+    CHECK(bytes == 14);
+
+    CHECK(py::mapped_records(file.path, 0).empty());
+    CHECK(py::mapped_records(file.path, 100).size() == 1);
+}
@@ -0,0 +1,79 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <array>                // for array
+#include <pyrange/ndrange.hpp>  // for ndrange, product
+#include <pyrange/range.hpp>    // for range
+#include <vector>               // for vector
+
+TEST_CASE("Test ndrange") {
+    const auto R = py::ndrange({3, 4});
+
+    CHECK(!R.empty());
+    CHECK(R.size() == 12);
+    CHECK(R.contains({2, 3}));
+    CHECK(!R.contains({3, 0}));
+    CHECK(R.dims[1].size() == 4);
+
+    auto count = size_t(0);
+    for (auto it = R.begin(); it != R.end(); ++it) {
+        const auto &idx = *it;
+        CHECK(idx[0] == int(count / 4));
+        CHECK(idx[1] == int(count % 4));
+        CHECK(it.linear() == count);
+        CHECK(R.linear(idx) == count);
+        CHECK(R[count] == idx);
+        ++count;
+    }
+    CHECK(count == R.size());
+
+    CHECK(py::ndrange({3, 0}).empty());
+    CHECK(py::ndrange({3, 0}).begin() == py::ndrange({3, 0}).end());
+}
+
+TEST_CASE("Test product") {
+    const auto R = py::product(py::range(-1, 1), py::range(3, 5), py::range(7, 9));
+
+    CHECK(R.size() == 8);
+    auto values = std::vector<std::array<int, 3>>{};
+    for (const auto &idx : py::product(py::range(-1, 1), py::range(2, 4))) {
+        values.push_back({idx[0], idx[1], 0});
+    }
+    CHECK(values.size() == 4);
+    CHECK(values[1] == std::array<int, 3>{-1, 3, 0});
+    CHECK(values[2] == std::array<int, 3>{0, 2, 0});
+}
+
+TEST_CASE("Test ndrange (tiled)") {
+    const auto R = py::ndrange({5, 5}, {2, 3});
+
+    auto seen = std::vector<int>(R.size(), 0);
+    auto order = std::vector<std::array<int, 2>>{};
+    for (auto it = R.begin(); it != R.end(); ++it) {
+        seen[it.linear()] += 1;
+        order.push_back(*it);
+    }
+    CHECK(order.size() == 25);
+    for (auto s : seen) {
+        CHECK(s == 1);
+    }
+
+    // first tile: rows 0..1, columns 0..2
+    CHECK(order[0] == std::array<int, 2>{0, 0});
+    CHECK(order[2] == std::array<int, 2>{0, 2});
+    CHECK(order[3] == std::array<int, 2>{1, 0});
+    // second tile: rows 0..1, columns 3..4 (clipped)
+    CHECK(order[6] == std::array<int, 2>{0, 3});
+    CHECK(order[9] == std::array<int, 2>{1, 4});
+    // third tile: rows 2..3, columns 0..2
+    CHECK(order[10] == std::array<int, 2>{2, 0});
+    // last tile: row 4, columns 3..4
+    CHECK(order[24] == std::array<int, 2>{4, 4});
+
+    const auto S = py::product(py::range(2, 6), py::range(1, 4)).tiled({3, 0});
+    auto count = 0;
+    for (const auto &idx : S) {
+        CHECK(S.contains(idx));
+        ++count;
+    }
+    CHECK(count == 12);
+}
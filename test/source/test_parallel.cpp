@@ -0,0 +1,105 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>              // for all_of
+#include <atomic>                 // for atomic
+#include <chrono>                 // for milliseconds
+#include <cstdint>                // for int64_t
+#include <mutex>                  // for mutex, lock_guard
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/parallel.hpp>   // for parallel_for, ThreadPool
+#include <pyrange/range.hpp>      // for range
+#include <stdexcept>              // for runtime_error
+#include <thread>                 // for sleep_for
+#include <utility>                // for pair
+#include <vector>                 // for vector
+
+TEST_CASE("Test parallel_for (Range)") {
+    py::ThreadPool pool(3);
+    const auto N = 100000;
+    auto visits = std::vector<std::atomic<int>>(N);
+    py::parallel_for(pool, py::range(N), [&visits](int i) { visits[size_t(i)] += 1; }, 1000);
+    CHECK(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int> &v) {
+        return v.load() == 1;
+    }));
+
+    std::atomic<std::int64_t> total{0};
+    py::parallel_for(py::range(1, N, 3), [&total](int i) { total += i; });
+    auto expected = std::int64_t(0);
+    for (auto i : py::range(1, N, 3)) {
+        expected += i;
+    }
+    CHECK(total == expected);
+}
+
+TEST_CASE("Test parallel_for (enumerate)") {
+    py::ThreadPool pool(2);
+    auto values = std::vector<double>(5000, 1.0);
+    py::parallel_for(
+        pool, py::enumerate(values),
+        [](const std::pair<size_t, double &> &p) { p.second += double(p.first); }, 64);
+    auto count = 0;
+    for (const auto &p : py::enumerate(values)) {
+        CHECK(p.second == 1.0 + double(p.first));
+        ++count;
+    }
+    CHECK(count == 5000);
+}
+
+TEST_CASE("Test parallel_for_chunk (deterministic)") {
+    py::ThreadPool pool(4);
+    std::mutex mtx;
+    auto chunks = std::vector<std::pair<int, int>>{};
+    py::parallel_for_chunk(
+        pool, py::range(10, 1010),
+        [&](const auto &sub) {
+            std::lock_guard<std::mutex> lock(mtx);
+            chunks.emplace_back(*sub.begin(), *sub.end());
+        },
+        128, py::Partition::Deterministic);
+    std::sort(chunks.begin(), chunks.end());
+
+    CHECK(chunks.size() == 8);
+    for (auto k = 0; k != 8; ++k) {
+        CHECK(chunks[size_t(k)].first == 10 + 128 * k);
+        CHECK(chunks[size_t(k)].second == std::min(10 + 128 * (k + 1), 1010));
+    }
+}
+
+TEST_CASE("Test parallel_for (long tasks)") {
+    // the caller runs out of tasks long before the workers finish theirs, and
+    // sleeps until the last one wakes it up
+    py::ThreadPool pool(3);
+    std::atomic<int> done{0};
+    py::parallel_for(
+        pool, py::range(4),
+        [&done](int i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5 * (i + 1)));
+            ++done;
+        },
+        1);
+    CHECK(done == 4);
+}
+
+TEST_CASE("Test parallel_for (nested and exceptions)") {
+    py::ThreadPool pool(2);
+    std::atomic<int> total{0};
+    py::parallel_for(
+        pool, py::range(8),
+        [&](int) { py::parallel_for(pool, py::range(100), [&](int) { ++total; }, 10); }, 1);
+    CHECK(total == 800);
+
+    CHECK_THROWS_AS(py::parallel_for(
+                        pool, py::range(1000),
+                        [](int i) {
+                            if (i == 567) {
+                                throw std::runtime_error("bad index");
+                            }
+                        },
+                        10),
+                    std::runtime_error);
+
+    py::ThreadPool serial(0);
+    auto count = 0;
+    py::parallel_for(serial, py::range(100), [&count](int) { ++count; }, 7);
+    CHECK(count == 100);
+}
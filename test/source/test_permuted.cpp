@@ -0,0 +1,84 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <algorithm>             // for count, sort
+#include <atomic>                // for atomic
+#include <cstddef>               // for size_t
+#include <pyrange/parallel.hpp>  // for parallel_for
+#include <pyrange/permuted.hpp>  // for permuted
+#include <pyrange/range.hpp>     // for range
+#include <vector>                // for vector
+
+#if defined(__cpp_lib_ranges)
+#    include <ranges>  // for views
+#endif
+
+TEST_CASE("Test permuted") {
+    for (auto n : {0, 1, 2, 3, 4, 5, 17, 64, 1000, 65539}) {
+        auto seen = std::vector<int>(size_t(n), 0);
+        auto count = 0;
+        for (auto i : py::permuted(py::range(n), 42)) {
+            CHECK(i >= 0);
+            CHECK(i < n);
+            ++seen[size_t(i)];
+            ++count;
+        }
+        CHECK(count == n);
+        CHECK(std::count(seen.begin(), seen.end(), 1) == n);
+    }
+}
+
+TEST_CASE("Test permuted (order)") {
+    auto p = py::permuted(py::range(1000), 7);
+    auto order = std::vector<int>(p.begin(), p.end());
+    CHECK(order == std::vector<int>(p.begin(), p.end()));  // deterministic
+
+    auto q = py::permuted(py::range(1000), 8);
+    CHECK(order != std::vector<int>(q.begin(), q.end()));
+
+    auto identity = std::vector<int>(py::range(1000).begin(), py::range(1000).end());
+    CHECK(order != identity);
+    auto fixed = 0;
+    for (auto k : py::range(1000)) {
+        fixed += order[size_t(k)] == k ? 1 : 0;
+        CHECK(p[size_t(k)] == order[size_t(k)]);
+        CHECK(p.begin()[k] == order[size_t(k)]);
+    }
+    CHECK(fixed < 20);  // about one for a random permutation
+
+    std::sort(order.begin(), order.end());
+    CHECK(order == identity);
+}
+
+TEST_CASE("Test permuted (step range)") {
+    auto p = py::permuted(py::range(10, 40, 3), 1);
+    CHECK(p.size() == 10);
+    CHECK(p.contains(13));
+    CHECK(!p.contains(14));
+    auto values = std::vector<int>(p.begin(), p.end());
+    std::sort(values.begin(), values.end());
+    CHECK(values == std::vector<int>{10, 13, 16, 19, 22, 25, 28, 31, 34, 37});
+}
+
+TEST_CASE("Test permuted (parallel)") {
+    const auto n = 100003;
+    auto hits = std::vector<std::atomic<int>>(size_t(n));
+    py::parallel_for(
+        py::permuted(py::range(n), 123), [&hits](int i) { ++hits[size_t(i)]; }, 1000);
+    auto ok = true;
+    for (auto &h : hits) {
+        ok = ok && h == 1;
+    }
+    CHECK(ok);
+}
+
+#if defined(__cpp_lib_ranges)
+TEST_CASE("Test permuted (C++20 views)") {
+    static_assert(std::ranges::random_access_range<decltype(py::permuted(py::range(5), 0))>);
+    static_assert(std::ranges::borrowed_range<decltype(py::permuted(py::range(5), 0))>);
+    auto sum = 0;
+    for (auto i : py::permuted(py::range(100), 3) | std::views::take(100)) {
+        sum += i;
+    }
+    CHECK(sum == 4950);
+}
+#endif
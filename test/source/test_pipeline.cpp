@@ -0,0 +1,97 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <forward_list>           // for forward_list
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/pipeline.hpp>   // for map, filter, take, accumulate, source
+#include <pyrange/range.hpp>      // for range
+#include <vector>                 // for vector
+
+TEST_CASE("Test pipeline") {
+    auto S = std::vector<int>{1, 2, 3, 4};
+    auto is_odd = [](int a) { return a % 2 == 1; };
+    auto rng = py::filter(is_odd, py::source(S));
+    CHECK(py::accumulate(rng, 0) == 4);
+    CHECK(py::accumulate(S, 0) == 10);
+}
+
+TEST_CASE("Test pipeline (range)") {
+    auto square = [](int i) { return i * i; };
+    auto is_even = [](int i) { return i % 2 == 0; };
+    // 0 + 4 + 16 + 36 + 64
+    CHECK(py::accumulate(py::map(square, py::filter(is_even, py::range(10))), 0) == 120);
+    // map before filter: 0 + 4 + 16 + 36 + 64, the squares that are even
+    CHECK(py::accumulate(py::filter(is_even, py::map(square, py::range(10))), 0) == 120);
+    CHECK(py::accumulate(py::range(0, 10, 3), 0) == 0 + 3 + 6 + 9);
+}
+
+TEST_CASE("Test pipeline (take)") {
+    auto calls = 0;
+    auto count = [&calls](int i) {
+        ++calls;
+        return i;
+    };
+    CHECK(py::accumulate(py::take(3, py::map(count, py::range(100))), 0) == 0 + 1 + 2);
+    CHECK(calls == 3);  // lazy: the rest of the range is never mapped
+
+    CHECK(py::accumulate(py::take(0, py::range(100)), 0) == 0);
+    CHECK(py::accumulate(py::take(50, py::range(5)), 0) == 10);
+    CHECK(py::accumulate(py::take(2, py::take(5, py::range(100))), 0) == 1);
+
+    auto is_odd = [](int a) { return a % 2 == 1; };
+    // 1 + 3 + 5 + 7
+    CHECK(py::accumulate(py::take(4, py::filter(is_odd, py::range(100))), 0) == 16);
+}
+
+TEST_CASE("Test pipeline (enumerate)") {
+    auto v = std::vector<int>{10, 20, 30, 40};
+    auto weighted = [](const std::pair<size_t, int &> &p) { return int(p.first) * p.second; };
+    CHECK(py::accumulate(py::map(weighted, py::enumerate(v)), 0) == 20 + 60 + 120);
+
+    py::for_each(py::enumerate(v),
+                 [](const std::pair<size_t, int &> &p) { p.second += int(p.first); });
+    CHECK(v == std::vector<int>{10, 21, 32, 43});
+}
+
+TEST_CASE("Test pipeline (single pass and rvalues)") {
+    auto l = std::forward_list<int>{5, 6, 7};
+    CHECK(py::accumulate(py::map([](int x) { return x - 5; }, l), 0) == 3);
+
+    auto rng = py::map([](int x) { return 2 * x; }, std::vector<int>{1, 2, 3});
+    CHECK(py::accumulate(rng, 0) == 12);
+    CHECK(py::accumulate(rng, 0) == 12);  // owned, can be run again
+
+    auto out = std::vector<int>{};
+    py::for_each(py::take(2, rng), [&out](int x) { out.push_back(x); });
+    CHECK(out == std::vector<int>{2, 4});
+}
+
+namespace {
+
+    // a container that counts how often it is copied
+    struct Counted {
+        static int copies;
+        std::vector<int> values;
+
+        explicit Counted(size_t n) : values(n, 1) {}
+        Counted(const Counted &other) : values(other.values) { ++copies; }
+        Counted(Counted &&) = default;
+
+        auto begin() const -> std::vector<int>::const_iterator { return values.begin(); }
+        auto end() const -> std::vector<int>::const_iterator { return values.end(); }
+    };
+
+    int Counted::copies = 0;
+
+}  // namespace
+
+TEST_CASE("Test pipeline (lvalue stages are not copied)") {
+    auto one = [](int x) { return x; };
+    auto p = py::map(one, Counted(1000));
+    CHECK(py::accumulate(p, 0) == 1000);
+    CHECK(py::accumulate(p, 0) == 1000);
+    CHECK(py::accumulate(py::take(10, py::filter([](int) { return true; }, p)), 0) == 10);
+    const auto &c = p;
+    CHECK(py::accumulate(py::map(one, c), 0) == 1000);
+    py::for_each(p, [](int) {});
+    CHECK(Counted::copies == 0);
+}
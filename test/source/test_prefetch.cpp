@@ -0,0 +1,106 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <array>                  // for array
+#include <atomic>                 // for atomic
+#include <cstddef>                // for size_t, nullptr_t
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/parallel.hpp>   // for parallel_for
+#include <pyrange/prefetch.hpp>   // for prefetched, PrefetchTarget
+#include <pyrange/range.hpp>      // for range
+#include <type_traits>            // for is_same
+#include <utility>                // for pair
+#include <vector>                 // for vector
+
+TEST_CASE("Test prefetched (pointer range)") {
+    auto A = std::array<double, 4>{0.2, 0.4, 0.1, 0.9};
+    auto values = std::vector<double>{};
+    for (auto p : py::prefetched(py::range(&A[0], &A[0] + 4), 2)) {
+        values.push_back(*p);
+    }
+    CHECK(values == std::vector<double>{0.2, 0.4, 0.1, 0.9});
+
+    // an array of pointers: the objects are what the loop misses on
+    auto objects = std::vector<int>{5, 6, 7, 8, 9};
+    auto ptrs = std::vector<int *>{};
+    for (auto k : {3, 0, 4, 1, 2}) {
+        ptrs.push_back(&objects[size_t(k)]);
+    }
+    auto sum = 0;
+    auto n = size_t(0);
+    for (auto p : py::prefetched(py::range(ptrs.data(), ptrs.data() + ptrs.size()))) {
+        sum += **p;
+        ++n;
+    }
+    CHECK(sum == 35);
+    CHECK(n == 5);
+}
+
+TEST_CASE("Test prefetched (target)") {
+    auto x = 1;
+    auto *p = &x;
+    const auto target = py::PrefetchTarget{};
+    CHECK(target(&p) == &x);  // pointer to a pointer: the object
+    CHECK(target(p) == &x);   // pointer held by a container: the object
+    CHECK(target(std::pair<size_t, int *&>{0, p}) == &x);
+    static_assert(std::is_same<decltype(target(&x)), std::nullptr_t>::value,
+                  "the pointers of range(ptr_begin, ptr_end) are left to the hardware");
+    static_assert(std::is_same<decltype(target(std::pair<size_t, int &>{0, x})),
+                               std::nullptr_t>::value,
+                  "contiguous elements are left to the hardware");
+    static_assert(std::is_same<decltype(target(3)), std::nullptr_t>::value,
+                  "integers are not prefetched");
+    static_assert(!py::PrefetchIterator<int *, py::PrefetchTarget>::active,
+                  "a contiguous scan steps like the plain loop");
+}
+
+TEST_CASE("Test prefetched (enumerate)") {
+    auto objects = std::vector<int>{10, 20, 30};
+    auto ptrs = std::vector<int *>{&objects[2], &objects[0], &objects[1]};
+
+    // the pointers are what the loop dereferences, in either order
+    static_assert(decltype(py::prefetched(ptrs))::iterator::active, "pointer elements");
+    static_assert(decltype(py::enumerate(py::prefetched(ptrs)).begin().iter)::active,
+                  "enumerate of prefetched");
+    static_assert(decltype(py::prefetched(py::enumerate(ptrs)))::iterator::active,
+                  "prefetched of enumerate");
+
+    auto weighted = 0;
+    for (auto p : py::enumerate(py::prefetched(ptrs, 1))) {
+        weighted += int(p.first) * *p.second;
+    }
+    CHECK(weighted == 0 * 30 + 1 * 10 + 2 * 20);
+
+    weighted = 0;
+    for (auto p : py::prefetched(py::enumerate(ptrs), 8)) {
+        weighted += int(p.first) * *p.second;
+        p.second = nullptr;  // the elements stay mutable
+    }
+    CHECK(weighted == 50);
+    CHECK(ptrs == std::vector<int *>(3, nullptr));
+}
+
+TEST_CASE("Test prefetched (gather and random access)") {
+    auto data = std::vector<double>(100, 0.5);
+    auto index = std::vector<int>{};
+    for (auto i : py::range(100)) {
+        index.push_back((i * 37) % 100);
+    }
+    auto gather = py::prefetched(index, 4, [&data](int i) { return &data[size_t(i)]; });
+    CHECK(gather.size() == 100);
+    CHECK(!gather.empty());
+    CHECK(gather.begin()[3] == 11);
+    CHECK(*(gather.end() - 1) == (99 * 37) % 100);
+
+    auto sum = 0.0;
+    for (auto i : gather) {
+        sum += data[size_t(i)];
+    }
+    CHECK(sum == 50.0);
+
+    std::atomic<int> count{0};
+    py::parallel_for(gather, [&count](int /* unused */) { ++count; }, 7);
+    CHECK(count == 100);
+
+    CHECK(py::prefetched(std::vector<int>{}).empty());
+    CHECK(py::prefetched(py::range(5), 100).size() == 5);
+}
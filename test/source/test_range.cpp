@@ -1,7 +1,18 @@
 #include <doctest/doctest.h>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
 #include <pyrange/range.hpp>
+#include <type_traits>
+#include <vector>
+#if __cplusplus >= 201703L && defined(__has_include)
+#    if __has_include(<execution>)
+#        include <execution>
+#    endif
+#endif
 // #include <range/v3/view/all.hpp>
 // #include <range/v3/view/remove_if.hpp>
 // #include <transranger_view.hpp>
@@ -77,3 +88,173 @@ TEST_CASE("Test Range (pointer)") {
     }
     CHECK(count == R.size());
 }
+
+TEST_CASE("Test RangeIterator (random access)") {
+    using Iter = py::RangeIterator<int>;
+    static_assert(std::is_same<std::iterator_traits<Iter>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "RangeIterator must be random access");
+
+    const auto R = py::range(-10, 10);
+    auto first = R.begin();
+    auto last = R.end();
+
+    CHECK(last - first == 20);
+    CHECK(first - last == -20);
+    CHECK(std::distance(first, last) == 20);
+    CHECK(*(first + 3) == -7);
+    CHECK(*(3 + first) == -7);
+    CHECK(*(last - 1) == 9);
+    CHECK(first[5] == -5);
+    CHECK(first < last);
+    CHECK(last > first);
+    CHECK(first <= first);
+    CHECK(last >= first);
+
+    auto it = first;
+    it += 15;
+    CHECK(*it == 5);
+    it -= 4;
+    CHECK(*it == 1);
+    CHECK(*it-- == 1);
+    CHECK(*--it == -1);
+
+    CHECK(*std::lower_bound(first, last, 4) == 4);
+}
+
+TEST_CASE("Test RangeIterator (temporaries)") {
+    // values are returned by copy, so dereferencing a temporary iterator is fine
+    static_assert(std::is_same<std::iterator_traits<py::RangeIterator<int>>::reference, int>::value,
+                  "RangeIterator yields values");
+    const auto R = py::range(10);
+    CHECK(*std::make_reverse_iterator(R.end()) == 9);
+    CHECK(std::make_reverse_iterator(R.end())[3] == 6);
+    CHECK(*(R.begin() + 7) == 7);
+    CHECK(R.begin()[3] == 3);
+
+    auto reversed = std::vector<int>(std::make_reverse_iterator(R.end()),
+                                     std::make_reverse_iterator(R.begin()));
+    CHECK(reversed == std::vector<int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+}
+
+TEST_CASE("Test RangeIterator (char and pointer)") {
+    const auto C = py::range('A', 'W');
+    CHECK(C.end() - C.begin() == 22);
+    CHECK(*(C.begin() + 3) == 'D');
+    CHECK(C.begin()[25 - 3] == 'W');
+    CHECK(*(C.end() - 1) == 'V');
+
+    const auto U = py::range(std::uint8_t(250), std::uint8_t(255));
+    CHECK(U.end() - U.begin() == 5);
+    CHECK(U.begin() - U.end() == -5);
+
+    const auto V = py::range(3U, 8U);
+    CHECK(V.begin() - V.end() == -5);
+    CHECK(*(V.end() - 5) == 3U);
+
+    auto A = std::array<double, 4>{0.2, 0.4, 0.1, 0.9};
+    auto P = py::range(&A[0], &A[0] + 4);
+    CHECK(P.end() - P.begin() == 4);
+    CHECK(*(P.begin() + 2) == &A[2]);
+    CHECK(**(P.end() - 1) == 0.9);
+}
+
+TEST_CASE("Test StepRange") {
+    static_assert(py::range(1, 10, 3).size() == 3, "size is known at compile time");
+    const auto R = py::range(1, 10, 3);  // 1, 4, 7
+
+    CHECK(!R.empty());
+    CHECK(R.size() == 3);
+    CHECK(R[2] == 7);
+    CHECK(R.contains(4));
+    CHECK(!R.contains(5));
+    CHECK(!R.contains(10));
+    CHECK(!R.contains(-2));
+
+    auto values = std::vector<int>(R.begin(), R.end());
+    CHECK(values == std::vector<int>{1, 4, 7});
+    CHECK(R.end() - R.begin() == 3);
+    CHECK(*(R.end() - 1) == 7);
+
+    CHECK(py::range(0, 9, 3).size() == 3);
+    CHECK(py::range(0, 10, 3).size() == 4);
+    CHECK(py::range(5, 5, 2).empty());
+    CHECK(py::range(5, 1, 2).empty());
+    CHECK(py::range(0, 10, 0).empty());
+}
+
+TEST_CASE("Test StepRange (negative step)") {
+    const auto R = py::range(10, -2, -4);  // 10, 6, 2
+
+    CHECK(R.size() == 3);
+    CHECK(R[1] == 6);
+    CHECK(R.contains(2));
+    CHECK(!R.contains(-2));
+    CHECK(!R.contains(14));
+
+    auto count = 0;
+    for (auto &&a : R) {
+        CHECK(a == 10 - 4 * count);
+        ++count;
+    }
+    CHECK(count == R.size());
+
+    const auto C = py::range('z', 'a', -5);
+    CHECK(C.size() == 5);
+    CHECK(C[4] == 'f');
+
+    const auto U = py::range(9U, 0U, -3);  // 9, 6, 3
+    CHECK(U.size() == 3);
+    CHECK(U[2] == 3U);
+    CHECK(U.contains(6U));
+    CHECK(!U.contains(0U));
+}
+
+TEST_CASE("Test StepRange (pointer)") {
+    auto A = std::array<double, 5>{0.2, 0.4, 0.1, 0.9, 0.5};
+    const auto R = py::range(&A[0], &A[0] + 5, 2);
+
+    CHECK(R.size() == 3);
+    CHECK(*R[2] == 0.5);
+    CHECK(R.contains(&A[2]));
+    CHECK(!R.contains(&A[3]));
+
+    auto total = 0.0;
+    for (auto p : R) {
+        total += *p;
+    }
+    CHECK(total == doctest::Approx(0.8));
+}
+
+TEST_CASE("Test reversed") {
+    auto values = std::vector<int>{};
+    for (auto i : py::reversed(py::range(4))) {
+        values.push_back(i);
+    }
+    CHECK(values == std::vector<int>{3, 2, 1, 0});
+    CHECK(py::reversed(py::range(0)).empty());
+
+    const auto R = py::reversed(py::range(1, 10, 3));
+    CHECK(std::vector<int>(R.begin(), R.end()) == std::vector<int>{7, 4, 1});
+}
+
+#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201603L
+TEST_CASE("Test Range with parallel algorithms") {
+    const auto N = 100000;
+    const auto R = py::range(N);
+
+    auto total = std::transform_reduce(std::execution::par_unseq, R.begin(), R.end(),
+                                       std::int64_t(0), std::plus<>(),
+                                       [](int i) { return std::int64_t(i); });
+    CHECK(total == std::int64_t(N) * (N - 1) / 2);
+
+    auto squares = std::vector<std::int64_t>(R.size());
+    std::for_each(std::execution::par, R.begin(), R.end(),
+                  [&squares](int i) { squares[size_t(i)] = std::int64_t(i) * i; });
+    CHECK(squares[317] == 317 * 317);
+
+    auto odd = std::count_if(std::execution::par_unseq, R.begin(), R.end(),
+                             [](int i) { return i % 2 == 1; });
+    CHECK(odd == N / 2);
+}
+#endif
@@ -0,0 +1,134 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <cstdint>                // for int64_t, uint8_t, uint32_t
+#include <list>                   // for list
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/range.hpp>      // for range
+#include <pyrange/reduce.hpp>     // for sum, reduce, count_if, count
+#include <vector>                 // for vector
+
+namespace {
+
+    template <typename Rng, typename T> auto naive_sum(const Rng &rng, T init) -> T {
+        for (auto x : rng) {
+            init = static_cast<T>(init + x);
+        }
+        return init;
+    }
+
+    template <typename Rng, typename Window> auto naive_count(const Rng &rng, const Window &w)
+        -> size_t {
+        auto n = size_t(0);
+        for (auto x : rng) {
+            n += w.contains(x) ? 1 : 0;
+        }
+        return n;
+    }
+
+}  // namespace
+
+TEST_CASE("Test sum (closed form)") {
+    CHECK(py::sum(py::range(10)) == 45);
+    CHECK(py::sum(py::range(-10, 10)) == -10);
+    CHECK(py::sum(py::range(5, 5)) == 0);
+    CHECK(py::sum(py::range(7, 3)) == 0);
+    CHECK(py::sum(py::range(1000000), int64_t(0)) == int64_t(499999500000));
+    CHECK(py::sum(py::range(0, 10, 3), 100) == 118);
+    CHECK(py::sum(py::range(10, -10, -3)) == naive_sum(py::range(10, -10, -3), 0));
+    CHECK(py::sum(py::range(4), 0.5) == 6.5);
+
+    // wrap-around as in the element-by-element sum
+    CHECK(py::sum(py::range(uint32_t(0), uint32_t(100000)))
+          == naive_sum(py::range(uint32_t(0), uint32_t(100000)), uint32_t(0)));
+    CHECK(py::sum(py::range(uint8_t(200), uint8_t(255)), uint8_t(7))
+          == naive_sum(py::range(uint8_t(200), uint8_t(255)), uint8_t(7)));
+
+    static_assert(py::sum(py::range(1, 101), 0) == 5050, "constant expression");
+
+    // a floating-point init does not wrap around, even past 2^64
+    const auto big = py::range(int64_t(0), int64_t(5000000000));
+    CHECK(py::sum(big, 0.0) == doctest::Approx(1.25e19));
+    CHECK(py::sum(py::range(int64_t(5000000000), int64_t(0), int64_t(-2)), 1.0)
+          == doctest::Approx(6.25e18));
+    CHECK(py::sum(py::range(int64_t(-3000000000), int64_t(0)), 0.0F)
+          == doctest::Approx(-4.5e18));
+    CHECK(py::sum(py::range(0, 10, 3), 0.0) == 18.0);
+    CHECK(py::sum(py::range(3, 3), 2.5) == 2.5);
+}
+
+TEST_CASE("Test sum (containers)") {
+    auto v = std::vector<int>{1, 2, 3, 4, 5};
+    CHECK(py::sum(v) == 15);
+    CHECK(py::sum(v, 10) == 25);
+    auto l = std::list<double>{0.5, 0.25};
+    CHECK(py::sum(l) == 0.75);
+    CHECK(py::sum(std::vector<int>{}) == 0);
+
+    // more than the parallel threshold, both partitions
+    auto big = std::vector<int64_t>(100003);
+    for (auto i : py::range(big.size())) {
+        big[i] = int64_t(i % 17);
+    }
+    const auto expected = naive_sum(big, int64_t(0));
+    CHECK(py::sum(big, int64_t(0)) == expected);
+    CHECK(py::sum(big, int64_t(0), py::Partition::Deterministic) == expected);
+    CHECK(py::sum(std::vector<int64_t>(big.begin(), big.begin() + 5000), int64_t(0),
+                  py::Partition::Deterministic)
+          == naive_sum(std::vector<int64_t>(big.begin(), big.begin() + 5000), int64_t(0)));
+}
+
+TEST_CASE("Test reduce (deterministic)") {
+    auto v = std::vector<double>(200001);
+    for (auto i : py::range(v.size())) {
+        v[i] = 1.0 / double(i + 1);
+    }
+    const auto a = py::reduce(v, 0.0, std::plus<>{}, py::Partition::Deterministic);
+    py::ThreadPool serial(0);
+    py::ThreadPool four(3);
+    CHECK(py::reduce(serial, v, 0.0, std::plus<>{}, py::Partition::Deterministic) == a);
+    CHECK(py::reduce(four, v, 0.0, std::plus<>{}, py::Partition::Deterministic) == a);
+    CHECK(py::reduce(v, 0.0, std::plus<>{}) == doctest::Approx(a));
+
+    auto maximum = [](int x, int y) { return x < y ? y : x; };
+    auto w = std::vector<int>(70000);
+    for (auto i : py::range(w.size())) {
+        w[i] = int((i * 7919) % 65521);
+    }
+    w[12345] = 1 << 20;
+    CHECK(py::reduce(w, 0, maximum) == 1 << 20);
+    CHECK(py::reduce(w, 0, maximum, py::Partition::Deterministic) == 1 << 20);
+}
+
+TEST_CASE("Test count_if") {
+    auto is_odd = [](int x) { return x % 2 != 0; };
+    CHECK(py::count_if(py::range(10), is_odd) == 5);
+    CHECK(py::count_if(py::range(100000), is_odd) == 50000);
+    auto v = std::vector<int>{1, 3, 4, 5};
+    CHECK(py::count_if(v, is_odd) == 3);
+    CHECK(py::count(v, 4) == 1);
+    CHECK(py::count(py::range(10), 4) == 1);
+    CHECK(py::count(py::range(10), 10) == 0);
+    CHECK(py::count(py::range(1, 20, 3), 7) == 1);
+    CHECK(py::count(py::range(1, 20, 3), 8) == 0);
+
+    auto e = py::enumerate(v);
+    CHECK(py::count_if(e, [](const std::pair<size_t, const int &> &p) {
+              return int(p.first) + 1 == p.second;
+          })
+          == 1);
+}
+
+TEST_CASE("Test count_if (window)") {
+    CHECK(py::count_if(py::range(10), py::range(3, 20)) == 7);
+    CHECK(py::count_if(py::range(10), py::range(12, 20)) == 0);
+    CHECK(py::count_if(py::range(10), py::range(5, 2)) == 0);
+    for (auto start : py::range(-7, 8)) {
+        for (auto step : {-5, -3, -1, 1, 2, 4}) {
+            for (auto lo : py::range(-9, 9, 4)) {
+                const auto rng = py::range(start, start + 6 * step + 1, step);
+                const auto window = py::range(lo, lo + 7);
+                CHECK(py::count_if(rng, window) == naive_count(rng, window));
+            }
+        }
+    }
+}
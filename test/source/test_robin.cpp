@@ -1,8 +1,13 @@
 #include <doctest/doctest.h>  // for ResultBuilder, CHECK, Expr...
 // #include <__config>                        // for std
-#include <cinttypes>          // for uint8_t
-#include <pyrange/robin.hpp>  // for Robin, Robin<>::iterable_w...
-#include <utility>            // for pair
+#include <atomic>             // for atomic
+#include <cinttypes>          // for uint8_t, uint64_t
+#include <cstdlib>            // for rand
+#include <pyrange/robin.hpp>  // for Robin, ArithRobin, ConcurrentRobin, ...
+#include <thread>             // for thread
+#include <type_traits>        // for true_type, false_type
+#include <utility>            // for pair, declval
+#include <vector>             // for vector
 
 using namespace std;
 
@@ -15,3 +20,295 @@ TEST_CASE("Test Robin") {
     }
     CHECK(count == 5);
 }
+
+TEST_CASE("Test ArithRobin") {
+    const fun::ArithRobin<uint8_t> rr(6U);
+    auto parts = vector<uint8_t>{};
+    for (auto i : rr.exclude(2)) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{3, 4, 5, 0, 1});
+
+    const fun::ArithRobin<uint8_t> single(1U);
+    CHECK(!(single.exclude(0).begin() != single.exclude(0).end()));
+}
+
+TEST_CASE("Test ArithRobin (same order as Robin)") {
+    for (auto n = 1U; n != 20U; ++n) {
+        const fun::Robin<unsigned> linked(n);
+        const fun::ArithRobin<unsigned> arith(n);
+        for (auto from = 0U; from != n; ++from) {
+            auto expected = vector<unsigned>{};
+            for (auto i : linked.exclude(from)) {
+                expected.push_back(i);
+            }
+            auto parts = vector<unsigned>{};
+            for (auto i : arith.exclude(from)) {
+                parts.push_back(i);
+            }
+            CHECK(parts == expected);
+        }
+    }
+
+    const fun::ArithRobin<uint8_t> full(255U);
+    auto count = 0U;
+    for (auto i : full.exclude(254U)) {
+        static_assert(sizeof i >= 0, "make compiler happy");
+        count += 1;
+    }
+    CHECK(count == 254U);
+}
+
+TEST_CASE("Test Robin (deactivate and reactivate)") {
+    fun::Robin<uint8_t> rr(6U);
+    rr.deactivate(3);
+    rr.deactivate(4);
+    rr.deactivate(4);
+    CHECK(!rr.is_active(4));
+    auto parts = vector<uint8_t>{};
+    for (auto i : rr.exclude(2)) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{5, 0, 1});
+
+    parts.clear();
+    for (auto i : rr.exclude(3)) {  // an inactive part excludes nothing
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{5, 0, 1, 2});
+
+    rr.reactivate(4);
+    auto copy = rr;  // the links are indices, so copies are independent
+    rr.deactivate(0);
+    parts.clear();
+    for (auto i : copy.exclude(1)) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{2, 4, 5, 0});
+
+    for (uint8_t p = 0; p != 6; ++p) {
+        rr.deactivate(p);
+    }
+    CHECK(rr.num_active == 0);
+    CHECK(!(rr.exclude(1).begin() != rr.exclude(1).end()));
+    rr.reactivate(2);
+    parts.clear();
+    for (auto i : rr.exclude(5)) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{2});
+}
+
+TEST_CASE("Test Robin (random activation)") {
+    const auto n = 37U;
+    fun::Robin<unsigned> rr(n);
+    auto active = vector<bool>(n, true);
+    srand(42);
+    for (auto step = 0; step != 2000; ++step) {
+        const auto part = unsigned(rand()) % n;
+        if (rand() % 2 == 0) {
+            rr.deactivate(part);
+            active[part] = false;
+        } else {
+            rr.reactivate(part);
+            active[part] = true;
+        }
+        const auto from = unsigned(rand()) % n;
+        auto expected = vector<unsigned>{};
+        for (auto k = 1U; k != n + 1; ++k) {
+            const auto i = (from + k) % n;
+            if (active[i] && i != from) {
+                expected.push_back(i);
+            }
+        }
+        auto parts = vector<unsigned>{};
+        for (auto i : rr.exclude(from)) {
+            parts.push_back(i);
+        }
+        REQUIRE(parts == expected);
+    }
+}
+
+TEST_CASE("Test ConcurrentRobin") {
+    fun::ConcurrentRobin<uint8_t> rr(3U);
+    CHECK(rr.next() == 0);
+    CHECK(rr.next() == 1);
+    CHECK(rr.next() == 2);
+    CHECK(rr.next() == 0);
+    CHECK(rr.next_excluding(1) == 0);  // tickets 4, 5, 6 map onto parts 0, 2
+    CHECK(rr.next_excluding(1) == 2);
+    CHECK(rr.next_excluding(1) == 0);
+}
+
+TEST_CASE("Test ConcurrentRobin (stress)") {
+    const auto num_parts = 7U;
+    const auto num_threads = 4U;
+    const auto calls = 7000U;
+    fun::ConcurrentRobin<unsigned> rr(num_parts);
+    auto hits = vector<atomic<unsigned>>(num_parts);
+    auto hits_excluding = vector<atomic<unsigned>>(num_parts);
+    auto threads = vector<thread>{};
+    for (auto t = 0U; t != num_threads; ++t) {
+        threads.emplace_back([&] {
+            for (auto i = 0U; i != calls; ++i) {
+                ++hits[rr.next()];
+            }
+        });
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    for (const auto &h : hits) {
+        CHECK(h == num_threads * calls / num_parts);
+    }
+
+    threads.clear();
+    for (auto t = 0U; t != num_threads; ++t) {
+        threads.emplace_back([&] {
+            for (auto i = 0U; i != (num_parts - 1) * 1000; ++i) {
+                ++hits_excluding[rr.next_excluding(3)];
+            }
+        });
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    CHECK(hits_excluding[3] == 0);
+    for (auto p = 0U; p != num_parts; ++p) {
+        if (p != 3) {
+            CHECK(hits_excluding[p] == num_threads * 1000);
+        }
+    }
+}
+
+TEST_CASE("Test WeightedRobin") {
+    fun::WeightedRobin<uint8_t> wr(vector<size_t>{5, 1, 1, 2});
+    auto parts = vector<uint8_t>{};
+    for (auto i : wr.exclude(3)) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{0, 0, 0, 1, 2, 0, 0});
+
+    wr.set_weight(1, 0);
+    wr.set_weight(2, 3);
+    parts.clear();
+    for (auto i : wr.exclude(0)) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{2, 3, 2, 3, 2});
+
+    // a round is consumed by iterating it: a second loop resumes at the pick
+    // where the first one stopped
+    auto round = wr.exclude(0);
+    parts.clear();
+    for (auto i : round) {
+        if (parts.size() == 2) {
+            break;
+        }
+        parts.push_back(i);
+    }
+    for (auto i : round) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{2, 3, 2, 3, 2});
+    CHECK(round.begin() == round.end());
+}
+
+TEST_CASE("Test WeightedRobin (equal weights are Robin)") {
+    const fun::Robin<unsigned> rr(9U);
+    const fun::WeightedRobin<unsigned> wr(9U);
+    for (auto from = 0U; from != 9U; ++from) {
+        auto expected = vector<unsigned>{};
+        for (auto i : rr.exclude(from)) {
+            expected.push_back(i);
+        }
+        auto parts = vector<unsigned>{};
+        for (auto i : wr.exclude(from)) {
+            parts.push_back(i);
+        }
+        CHECK(parts == expected);
+    }
+}
+
+TEST_CASE("Test WeightedRobin (distribution)") {
+    const auto weights = vector<size_t>{8, 32, 8, 16, 1, 32};
+    const fun::WeightedRobin<unsigned> wr(weights);
+    auto total = size_t(0);
+    for (auto w : weights) {
+        total += w;
+    }
+    const auto from = 4U;
+    auto count = vector<size_t>(weights.size());
+    auto last = vector<size_t>(weights.size(), 0);
+    auto step = size_t(0);
+    for (auto i : wr.exclude(from)) {
+        ++step;
+        // smooth: consecutive picks of a part are about total / weight apart
+        if (count[i] != 0) {
+            CHECK(double(step - last[i]) <= 1.5 * double(total) / double(weights[i]) + 1.0);
+        }
+        ++count[i];
+        last[i] = step;
+    }
+    CHECK(step == total - weights[from]);
+    for (auto p = 0U; p != weights.size(); ++p) {
+        CHECK(count[p] == (p == from ? 0 : weights[p]));
+    }
+}
+
+template <typename Mask, typename = void> struct takes_mask : false_type {};
+
+template <typename Mask>
+struct takes_mask<Mask, decltype(declval<const fun::Robin<uint8_t> &>().exclude(
+                                     declval<Mask>(), uint8_t(0)),
+                                 void())> : true_type {};
+
+TEST_CASE("Test Robin (exclude mask)") {
+    static_assert(takes_mask<vector<uint64_t> &>::value, "a mask that outlives the loop");
+    static_assert(!takes_mask<vector<uint64_t>>::value, "a temporary mask would dangle");
+
+    fun::Robin<uint8_t> rr(6U);
+    auto mask = vector<uint64_t>{(1U << 0U) | (1U << 4U)};
+    auto parts = vector<uint8_t>{};
+    for (auto i : rr.exclude(mask, 2)) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{3, 5, 1});
+
+    rr.deactivate(5);
+    parts.clear();
+    for (auto i : rr.exclude(mask, 4)) {
+        parts.push_back(i);
+    }
+    CHECK(parts == vector<uint8_t>{1, 2, 3});
+
+    mask[0] = 0x3FU;
+    CHECK(!(rr.exclude(mask, 0).begin() != rr.exclude(mask, 0).end()));
+}
+
+TEST_CASE("Test Robin (exclude mask, many parts)") {
+    const auto n = 200U;
+    fun::Robin<unsigned> rr(n);
+    srand(7);
+    for (auto round = 0; round != 50; ++round) {
+        auto mask = vector<uint64_t>(size_t(round % 5));  // may be shorter than needed
+        for (auto &word : mask) {
+            word = (uint64_t(rand()) << 32U) ^ uint64_t(rand());
+        }
+        const auto victim = unsigned(rand()) % n;
+        rr.deactivate(victim);
+        const auto from = unsigned(rand()) % n;
+        auto expected = vector<unsigned>{};
+        for (auto i : rr.exclude(from)) {
+            if (i / 64 >= mask.size() || (mask[i / 64] >> (i % 64) & 1U) == 0) {
+                expected.push_back(i);
+            }
+        }
+        auto parts = vector<unsigned>{};
+        for (auto i : rr.exclude(mask, from)) {
+            parts.push_back(i);
+        }
+        REQUIRE(parts == expected);
+        rr.reactivate(victim);
+    }
+}
@@ -0,0 +1,101 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <array>                     // for array
+#include <cstddef>                   // for ptrdiff_t, size_t
+#include <pyrange/enumerate.hpp>     // for enumerate
+#include <pyrange/range.hpp>         // for range
+#include <pyrange/static_range.hpp>  // for static_range, static_for
+#include <tuple>                     // for get, make_tuple
+#include <type_traits>               // for integral_constant
+#include <utility>                   // for pair
+#include <vector>                    // for vector
+
+namespace {
+
+    template <typename SRange> auto values() -> std::vector<std::ptrdiff_t> {
+        auto out = std::vector<std::ptrdiff_t>{};
+        py::static_for(SRange{}, [&out](auto i) { out.push_back(i); });
+        return out;
+    }
+
+    template <typename Rng> auto runtime_values(const Rng &rng) -> std::vector<std::ptrdiff_t> {
+        auto out = std::vector<std::ptrdiff_t>{};
+        for (auto i : rng) {
+            out.push_back(i);
+        }
+        return out;
+    }
+
+    constexpr auto static_sum() -> std::ptrdiff_t {
+        auto total = std::ptrdiff_t(0);
+        py::static_for<5>([&total](auto i) { total += i; });
+        return total;
+    }
+
+}  // namespace
+
+TEST_CASE("Test static_range") {
+    static_assert(py::static_range<0, 4>::size() == 4, "size");
+    static_assert(py::static_range<0, 10, 3>::size() == 4, "size");
+    static_assert(py::static_range<10, 0, -3>::size() == 4, "size");
+    static_assert(py::static_range<4, 4>::empty(), "empty");
+    static_assert(py::static_range<4, 0>::empty(), "empty");
+    static_assert(py::static_range<2, 9, 2>{}[3] == 8, "operator[]");
+
+    CHECK(values<py::static_range<0, 4>>() == runtime_values(py::range(std::ptrdiff_t(4))));
+    CHECK(values<py::static_range<-3, 10, 4>>()
+          == runtime_values(py::range(std::ptrdiff_t(-3), std::ptrdiff_t(10), 4)));
+    CHECK(values<py::static_range<7, -5, -3>>()
+          == runtime_values(py::range(std::ptrdiff_t(7), std::ptrdiff_t(-5), -3)));
+    CHECK(values<py::static_range<3, 3>>().empty());
+
+    const py::StepRange<std::ptrdiff_t> rng = py::static_range<1, 8, 2>{};
+    CHECK(runtime_values(rng) == std::vector<std::ptrdiff_t>{1, 3, 5, 7});
+}
+
+TEST_CASE("Test static_for") {
+    // the index is a compile-time constant
+    auto t = std::make_tuple(1, 2.5, 'c');
+    auto count = 0;
+    py::static_for<3>([&](auto i) {
+        static_assert(decltype(i)::value >= 0 && decltype(i)::value < 3, "constant index");
+        CHECK(std::get<i>(t) == std::get<decltype(i)::value>(t));
+        ++count;
+    });
+    CHECK(count == 3);
+
+    auto m = std::array<std::array<int, 4>, 4>{};
+    py::static_for<4>([&m](auto i) {
+        constexpr auto row = decltype(i)::value;
+        py::static_for<4>([&m](auto j) { std::get<j>(std::get<row>(m)) = int(4 * row + j); });
+    });
+    CHECK(m[2][3] == 11);
+
+    auto odd = std::vector<std::ptrdiff_t>{};
+    py::static_for<1, 8, 2>([&odd](auto i) { odd.push_back(i); });
+    CHECK(odd == std::vector<std::ptrdiff_t>{1, 3, 5, 7});
+
+#if __cpp_constexpr >= 201603
+    static_assert(static_sum() == 10, "constexpr loop");
+#endif
+    CHECK(static_sum() == 10);
+}
+
+TEST_CASE("Test static_for (enumerate)") {
+    auto a = std::array<int, 4>{{5, 6, 7, 8}};
+    auto body = [](const std::pair<size_t, int &> &p) { p.second += int(p.first); };
+
+    auto b = a;
+    py::static_for(py::enumerate(a), body);
+    for (const auto &p : py::enumerate(b)) {
+        body(p);
+    }
+    CHECK(a == b);
+    CHECK(a == std::array<int, 4>{{5, 7, 9, 11}});
+
+    const auto &c = a;
+    auto total = 0;
+    py::static_for(py::enumerate<int>(c, 10),
+                   [&total](const std::pair<int, const int &> &p) { total += p.first * p.second; });
+    CHECK(total == 10 * 5 + 11 * 7 + 12 * 9 + 13 * 11);
+}
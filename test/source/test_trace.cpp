@@ -0,0 +1,105 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#define PYRANGE_TRACE 1
+
+#include <cstddef>                // for size_t
+#include <pyrange/enumerate.hpp>  // for enumerate
+#include <pyrange/range.hpp>      // for range
+#include <pyrange/robin.hpp>      // for Robin
+#include <pyrange/trace.hpp>      // for PYRANGE_TRACED, trace_stats, write_chrome_trace
+#include <sstream>                // for ostringstream
+#include <string>                 // for string
+#include <thread>                 // for thread
+#include <vector>                 // for vector
+
+namespace {
+
+    auto find(const std::vector<py::TraceStats> &stats, const std::string &expr)
+        -> const py::TraceStats * {
+        for (const auto &s : stats) {
+            if (s.site->expr == expr) {
+                return &s;
+            }
+        }
+        return nullptr;
+    }
+
+}  // namespace
+
+TEST_CASE("Test trace") {
+    py::trace_reset();
+    auto total = 0;
+    for (auto n : {0, 1, 5, 100}) {
+        for (auto i : PYRANGE_TRACED(py::range(n))) {
+            total += i;
+        }
+    }
+    CHECK(total == 10 + 4950);
+
+    auto v = std::vector<int>{3, 4, 5};
+    for (auto p : PYRANGE_TRACED(py::enumerate(v))) {
+        p.second += int(p.first);
+    }
+    CHECK(v == std::vector<int>{3, 5, 7});
+
+    auto rr = fun::Robin<unsigned>(6U);
+    auto visited = 0;
+    for (auto k : PYRANGE_TRACED(rr.exclude(2U))) {
+        static_cast<void>(k);
+        ++visited;
+    }
+    CHECK(visited == 5);
+
+    for (auto i : PYRANGE_TRACED(py::range(1000))) {
+        if (i == 9) {
+            break;  // recorded with the iterations done so far
+        }
+    }
+
+    const auto stats = py::trace_stats();
+    CHECK(stats.size() == 4);
+    const auto *range = find(stats, "py::range(n)");
+    REQUIRE(range != nullptr);
+    CHECK(range->calls == 4);
+    CHECK(range->iterations == 106);
+    CHECK(range->trips[0] == 1);  // 0
+    CHECK(range->trips[1] == 1);  // 1
+    CHECK(range->trips[3] == 1);  // 5 is in [4, 8)
+    CHECK(range->trips[7] == 1);  // 100 is in [64, 128)
+    CHECK(find(stats, "py::enumerate(v)")->iterations == 3);
+    CHECK(find(stats, "rr.exclude(2U)")->iterations == 5);
+    CHECK(find(stats, "py::range(1000)")->iterations == 9);
+}
+
+TEST_CASE("Test trace (threads and export)") {
+    py::trace_reset();
+    auto threads = std::vector<std::thread>{};
+    for (auto t : py::range(3)) {
+        threads.emplace_back([t]() {
+            auto sum = size_t(0);
+            for (auto i : PYRANGE_TRACED(py::range(size_t(t) * 10))) {
+                sum += i;
+            }
+            static_cast<void>(sum);
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    const auto stats = py::trace_stats();
+    REQUIRE(stats.size() == 1);
+    CHECK(stats[0].calls == 3);
+    CHECK(stats[0].iterations == 30);
+
+    auto json = std::ostringstream{};
+    py::write_chrome_trace(json);
+    CHECK(json.str().find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.str().find("\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.str().find("\"trips\":20") != std::string::npos);
+    CHECK(json.str().find("e+") == std::string::npos);  // fixed-point time stamps
+
+    auto table = std::ostringstream{};
+    py::write_trace_summary(table);
+    CHECK(table.str().find("test_trace.cpp") != std::string::npos);
+    CHECK(table.str().find("[16,32):1") != std::string::npos);
+}
@@ -0,0 +1,115 @@
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST...
+
+#include <array>              // for array
+#include <iterator>           // for iterator_traits, random_access_iterator_tag
+#include <list>               // for list
+#include <pyrange/range.hpp>  // for range
+#include <pyrange/zip.hpp>    // for zip, for_each_zip
+#include <tuple>              // for get, tuple
+#include <type_traits>        // for is_same
+#include <vector>             // for vector
+
+TEST_CASE("Test zip") {
+    auto a = std::vector<int>{1, 2, 3, 4};
+    auto b = std::vector<double>{0.5, 1.5, 2.5, 3.5};
+    auto count = 0;
+    for (auto t : py::zip(a, b)) {
+        CHECK(std::get<0>(t) == a[count]);
+        CHECK(std::get<1>(t) == b[count]);
+        ++count;
+    }
+    CHECK(count == 4);
+}
+
+TEST_CASE("Test zip (references)") {
+    auto a = std::vector<int>{1, 2, 3};
+    auto b = std::vector<int>{10, 20, 30};
+    for (auto t : py::zip(a, b)) {
+        std::get<0>(t) += std::get<1>(t);
+    }
+    CHECK(a == std::vector<int>{11, 22, 33});
+
+    const auto &c = b;
+    auto z = py::zip(a, c);
+    using It = decltype(z.begin());
+    static_assert(
+        std::is_same<std::iterator_traits<It>::reference, std::tuple<int &, const int &>>::value,
+        "zip yields references");
+}
+
+TEST_CASE("Test zip (shortest input)") {
+    auto a = std::vector<int>{1, 2, 3, 4, 5};
+    auto b = std::array<char, 3>{{'a', 'b', 'c'}};
+    auto c = py::range(10);
+    auto z = py::zip(a, b, c);
+    CHECK(z.size() == 3);
+    auto count = 0;
+    for (auto t : z) {
+        CHECK(std::get<0>(t) == count + 1);
+        CHECK(std::get<1>(t) == 'a' + count);
+        CHECK(std::get<2>(t) == count);
+        ++count;
+    }
+    CHECK(count == 3);
+
+    auto l = std::list<int>{7, 8};
+    auto count2 = 0;
+    for (auto t : py::zip(a, l)) {
+        CHECK(std::get<1>(t) == 7 + count2);
+        ++count2;
+    }
+    CHECK(count2 == 2);
+}
+
+TEST_CASE("Test zip (random access)") {
+    auto a = std::vector<int>{5, 6, 7, 8, 9};
+    auto b = std::vector<int>{0, 1, 2, 3, 4, 5};
+    auto z = py::zip(a, b);
+    using It = decltype(z.begin());
+    static_assert(std::is_same<std::iterator_traits<It>::iterator_category,
+                               std::random_access_iterator_tag>::value,
+                  "random access when all inputs are");
+    static_assert(std::is_same<decltype(z.end()), It>::value, "common range");
+
+    auto first = z.begin();
+    auto last = z.end();
+    CHECK(last - first == 5);
+    CHECK(std::get<0>(first[2]) == 7);
+    CHECK(std::get<1>(*(first + 3)) == 3);
+    CHECK(std::get<0>(*(last - 1)) == 9);
+    CHECK(first < last);
+    auto it = last;
+    --it;
+    it -= 2;
+    CHECK(it - first == 2);
+
+    const auto R = py::range(10, 20);
+    CHECK(std::get<0>(py::zip(R, a).begin()[3]) == 13);
+    CHECK(std::get<1>(py::zip(R, a).begin()[3]) == 8);
+
+    auto l = std::list<int>{1, 2};
+    using Lt = decltype(py::zip(a, l).begin());
+    static_assert(std::is_same<std::iterator_traits<Lt>::iterator_category,
+                               std::bidirectional_iterator_tag>::value,
+                  "weakest category of the inputs");
+}
+
+TEST_CASE("Test zip (rvalue)") {
+    auto a = std::vector<int>{1, 2, 3};
+    auto z = py::zip(a, std::vector<int>{4, 5, 6, 7});
+    auto sum = 0;
+    for (auto t : z) {
+        sum += std::get<0>(t) * std::get<1>(t);
+    }
+    CHECK(sum == 1 * 4 + 2 * 5 + 3 * 6);
+    CHECK(&z.get<0>() == &a);
+    CHECK(z.get<1>().size() == 4);
+}
+
+TEST_CASE("Test for_each_zip") {
+    auto out = std::vector<float>(6);
+    const auto a = std::vector<float>{1, 2, 3, 4, 5, 6};
+    const auto b = std::vector<float>{6, 5, 4, 3, 2, 1, 0};
+    py::for_each_zip(py::zip(out, a, b), [](float &o, float x, float y) { o = x * y; });
+    CHECK(out == std::vector<float>{6, 10, 12, 12, 10, 6});
+}
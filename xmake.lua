@@ -1,4 +1,4 @@
-set_languages("c++14")
+set_languages("c++17")
 
 add_rules("mode.debug", "mode.release", "mode.coverage")
 add_requires("doctest", {alias = "doctest"})
@@ -12,6 +12,8 @@ end
 if is_plat("linux") then
     set_warnings("all", "error")
     add_cxflags("-Wconversion", {force = true})
+    -- libstdc++ runs the parallel algorithms on top of TBB
+    add_requires("tbb", {alias = "tbb"})
 end
 
 
@@ -20,6 +22,10 @@ target("test_pyrange")
     add_includedirs("include", {public = true})
     add_files("test/source/*.cpp")
     add_packages("doctest", "fmt")
+    if is_plat("linux") then
+        add_packages("tbb")
+        add_syslinks("pthread")
+    end
 
 -- If you want to known more usage about xmake, please see https://xmake.io
 --